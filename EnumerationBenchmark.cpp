@@ -0,0 +1,51 @@
+/**
+ * @file EnumerationBenchmark.cpp
+ * @brief Micro-benchmark of EnumDictionary lookups: a frozen dictionary (flat tables) against an unfrozen one (maps).
+ *
+ * Usage: EnumerationBenchmark [iterations] (default: 1000000)
+ */
+
+#include "EnumerationProperTypes.h"
+#include "PropertiesBenchmark.h"
+
+#include <stdio.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace PropertiesBenchmark;
+
+namespace {
+void benchmarkEnumDictionary(size_t iterations) {
+  EnumDictionary::IntToStr values;
+  for (int i = 0; i < 64; ++i) {
+    char name[32];
+    snprintf(name, sizeof(name), "VALUE_%d", i);
+    values[i] = name;
+  }
+  std::atomic<EnumDictionary*> maps(nullptr);
+  std::atomic<EnumDictionary*> frozen(nullptr);
+  EnumDictionary::set(maps, values, false);
+  EnumDictionary::set(frozen, values, true);
+  std::vector<MEtl::string> names;
+  for (EnumDictionary::IntToStrIt it = values.begin(); it != values.end(); ++it) {
+    names.push_back(it->second);
+  }
+
+  EnumDictionary::Reader mapsReader(&maps);
+  EnumDictionary::Reader frozenReader(&frozen);
+  double mapsToStr = opsPerSecond(iterations, [&](size_t i) { g_sink += (*mapsReader)(int(i & 63)).size(); });
+  double frozenToStr = opsPerSecond(iterations, [&](size_t i) { g_sink += (*frozenReader)(int(i & 63)).size(); });
+  report("EnumDictionary int->str", "maps", mapsToStr);
+  report("", "frozen (dense table)", frozenToStr, mapsToStr);
+  double mapsToInt = opsPerSecond(iterations, [&](size_t i) { g_sink += (*mapsReader)[names[i & 63]]; });
+  double frozenToInt = opsPerSecond(iterations, [&](size_t i) { g_sink += (*frozenReader)[names[i & 63]]; });
+  report("EnumDictionary str->int", "maps", mapsToInt);
+  report("", "frozen (hash table)", frozenToInt, mapsToInt);
+}
+}// namespace
+
+int main(int argc, char* argv[]) {
+  benchmarkEnumDictionary(iterations(argc, argv));
+  return 0;
+}
@@ -7,10 +7,14 @@
 
 #include "functionality/calibration/EnumerationProperTypes.h"
 
-OptimizeEnumeration::OptimizeEnumeration(int val,const EnumDictionary& dictionary)
+OptimizeEnumeration::OptimizeEnumeration(int val,const std::atomic<EnumDictionary*>& dictionary)
 :_val(val),
  _dictionary(dictionary){}
 
+OptimizeEnumeration::OptimizeEnumeration(int val,const EnumDictionary& dictionary)
+:_val(val),
+ _dictionary(*dictionary._slot){} //every dictionary is created by set() or update(), which set its slot
+
 OptimizeEnumeration::OptimizeEnumeration(const OptimizeEnumeration& other)
 :_dictionary(other._dictionary)
 {
@@ -24,12 +28,14 @@ OptimizeEnumeration::operator const int() const
 OptimizeEnumeration::~OptimizeEnumeration(){}
 MEtl::string OptimizeEnumeration::operator[](int val) const
 {
-  return _dictionary[val];
+  EnumDictionary::Reader dictionary(&_dictionary);
+  return dictionary ? (*dictionary)[val] : EnumDictionary::INVALID_STR_VAL;
 }
 
 int OptimizeEnumeration::operator[](const MEtl::string& strVal) const
 {
-  return _dictionary[strVal];
+  EnumDictionary::Reader dictionary(&_dictionary);
+  return dictionary ? (*dictionary)[strVal] : EnumDictionary::INVALID_VAL;
 }
 
 const OptimizeEnumeration& OptimizeEnumeration::operator=(const OptimizeEnumeration& other)
@@ -58,13 +64,48 @@ MEtl::string ttoa(const OptimizeEnumeration& t){
 
 const char* ttot(const OptimizeEnumeration& t){return "OptimizeEnumeration";}
 
+EnumValue& atot(EnumValue& t, const MEtl::string& a){
+  EnumDictionary::Reader dictionary(EnumDictionary::slotById(t.dictionaryId()));
+  t._val = dictionary ? (*dictionary)[a] : EnumDictionary::INVALID_VAL;
+  if(t._val == EnumDictionary::INVALID_VAL){
+    fprintf(stderr, "can't find matching enumeration for string value %s\n", a.c_str());
+  }
+  return t;
+}
+
+MEtl::string ttoa(const EnumValue& t){
+  EnumDictionary::Reader dictionary(EnumDictionary::slotById(t.dictionaryId()));
+  const char* strVal = dictionary ? dictionary->c_str(t) : NULL;
+  if(!strVal){
+    fprintf(stderr, "can't find matching enumeration for numeric value %d\n", static_cast<int>(t));
+    return EnumDictionary::INVALID_STR_VAL;
+  }
+  return strVal; //copied while the reader still holds the dictionary
+}
+
+const char* ttot(const EnumValue& t){return "EnumValue";}
+
 
 const MEtl::string EnumDictionary::INVALID_STR_VAL = "";
 void EnumDictionary::set(std::atomic<EnumDictionary*>& dictionary, const IntToStr& intToStr,bool freeze )
 {
-  EnumDictionary* expected(NULL);
   EnumDictionary* newVal(new EnumDictionary());
   newVal->init(intToStr,freeze);
+  install(dictionary, newVal);
+}
+
+void EnumDictionary::set(std::atomic<EnumDictionary*>& dictionary, const EnumTableView& table)
+{
+  EnumDictionary* newVal(new EnumDictionary());
+  newVal->_table = table;
+  newVal->_freeze = true;
+  install(dictionary, newVal);
+}
+
+void EnumDictionary::install(std::atomic<EnumDictionary*>& dictionary, EnumDictionary* newVal)
+{
+  EnumDictionary* expected(NULL);
+  newVal->_slot = &dictionary;
   while(!dictionary.compare_exchange_strong(expected, newVal)){
     if(dictionary != NULL){
       delete newVal;
@@ -74,6 +115,142 @@ void EnumDictionary::set(std::atomic<EnumDictionary*>& dictionary, const IntToSt
   }
 }
 
+namespace
+{
+struct DictionaryIds
+{
+  std::atomic<std::atomic<EnumDictionary*>*> slots[EnumDictionary::MAX_DICTIONARY_IDS];
+  std::atomic<unsigned int>                  count;
+  std::mutex                                 mutex; //serializes registrations only
+};
+
+DictionaryIds& dictionaryIds()
+{
+  //intentionally leaked: ids may be used by static objects during exit
+  static DictionaryIds* ids = new DictionaryIds();
+  return *ids;
+}
+}
+
+unsigned int EnumDictionary::registerId(std::atomic<EnumDictionary*>& dictionary)
+{
+  DictionaryIds& ids = dictionaryIds();
+  std::lock_guard<std::mutex> lock(ids.mutex);
+  unsigned int count = ids.count.load(std::memory_order_relaxed);
+  for (unsigned int id = 1; id <= count; id++)
+  {
+    if(ids.slots[id].load(std::memory_order_relaxed) == &dictionary){
+      return id;
+    }
+  }
+  if(count + 1 >= MAX_DICTIONARY_IDS){
+    fprintf(stderr, "too many enum dictionaries registered (max %u)\n", MAX_DICTIONARY_IDS - 1);
+    return 0;
+  }
+  ids.slots[count + 1].store(&dictionary, std::memory_order_release);
+  ids.count.store(count + 1, std::memory_order_release);
+  return count + 1;
+}
+
+const std::atomic<EnumDictionary*>* EnumDictionary::slotById(unsigned int id)
+{
+  if(id == 0 || id >= MAX_DICTIONARY_IDS){
+    return NULL;
+  }
+  return dictionaryIds().slots[id].load(std::memory_order_acquire);
+}
+
+const EnumDictionary* EnumDictionary::byId(unsigned int id)
+{
+  const std::atomic<EnumDictionary*>* slot = slotById(id);
+  return slot ? slot->load(std::memory_order_acquire) : NULL;
+}
+
+EpochDomain& EnumDictionary::domain()
+{
+  //intentionally leaked: retired dictionaries may be read by static objects during exit
+  static EpochDomain* domain = new EpochDomain();
+  return *domain;
+}
+
+EnumDictionary* EnumDictionary::clone() const
+{
+  EnumDictionary* copy(new EnumDictionary());
+  copy->_startIntToStr = _startIntToStr;
+  copy->_intToStr = _intToStr;
+  copy->_strToInt = _strToInt;
+  copy->_freeze = _freeze;
+  copy->_table = _table;
+  if(copy->_freeze && !copy->isStatic()){
+    copy->buildFrozen(); //the flat tables point into the maps, they are not copied
+  }
+  return copy;
+}
+
+template<typename UPDATE>
+void EnumDictionary::update(std::atomic<EnumDictionary*>& dictionary, UPDATE updateCopy, bool retire)
+{
+  //current may be replaced and retired by a concurrent writer while it is copied, so it is read inside a guard
+  EpochDomain::Guard guard(domain());
+  EnumDictionary* current = dictionary.load(std::memory_order_acquire);
+  while(current && updateCopy(*current, NULL)){
+    EnumDictionary* copy = current->clone();
+    copy->_slot = &dictionary;
+    updateCopy(*current, copy);
+    if(dictionary.compare_exchange_strong(current, copy, std::memory_order_acq_rel)){
+      if(retire){
+        domain().retire(current);
+      }
+      return;
+    }
+    //another writer won; current now holds its dictionary
+    delete copy;
+  }
+}
+
+void EnumDictionary::append(std::atomic<EnumDictionary*>& dictionary, const IntToStr& intToStr, bool freeze)
+{
+  appendTo(dictionary, intToStr, freeze, true);
+}
+
+void EnumDictionary::reset(std::atomic<EnumDictionary*>& dictionary)
+{
+  resetTo(dictionary, true);
+}
+
+void EnumDictionary::append(const IntToStr& intToStr, bool freeze)
+{
+  appendTo(*_slot, intToStr, freeze, false);
+}
+
+void EnumDictionary::reset()
+{
+  resetTo(*_slot, false);
+}
+
+void EnumDictionary::appendTo(std::atomic<EnumDictionary*>& dictionary, const IntToStr& intToStr, bool freeze, bool retire)
+{
+  //the first call only checks whether an update is needed, the second applies it to the copy
+  update(dictionary, [&](const EnumDictionary& current, EnumDictionary* copy){
+    if(!copy){
+      return !current._freeze;
+    }
+    copy->appendInPlace(intToStr, freeze);
+    return true;
+  }, retire);
+}
+
+void EnumDictionary::resetTo(std::atomic<EnumDictionary*>& dictionary, bool retire)
+{
+  update(dictionary, [](const EnumDictionary& current, EnumDictionary* copy){
+    if(!copy){
+      return !current.isStatic();
+    }
+    copy->resetInPlace();
+    return true;
+  }, retire);
+}
+
 void EnumDictionary::init(const IntToStr& intToStr,bool freeze)
 {
   _freeze = freeze;
@@ -83,10 +260,17 @@ void EnumDictionary::init(const IntToStr& intToStr,bool freeze)
     _intToStr[it->first] = it->second;
     _startIntToStr[it->first] = it->second;
   }
+  if(_freeze){
+    buildFrozen();
+  }
 }
-void EnumDictionary::reset()
+void EnumDictionary::resetInPlace()
 {
+  if(isStatic()){
+    return;
+  }
   _freeze = false;
+  clearFrozen();
   _intToStr.clear();
   _strToInt.clear();
   for (IntToStrIt it = _startIntToStr.begin(); it != _startIntToStr.end(); it++)
@@ -96,7 +280,7 @@ void EnumDictionary::reset()
   }
 }
 
-void EnumDictionary::append(const IntToStr& intToStr, bool freeze)
+void EnumDictionary::appendInPlace(const IntToStr& intToStr, bool freeze)
 {
   if(_freeze){
     return;
@@ -109,6 +293,9 @@ void EnumDictionary::append(const IntToStr& intToStr, bool freeze)
       _strToInt[it->second] = it->first;
     }
   }
+  if(_freeze){
+    buildFrozen();
+  }
 }
 bool EnumDictionary::isFreeze() const
 {
@@ -116,6 +303,13 @@ bool EnumDictionary::isFreeze() const
 }
 void EnumDictionary::getListStr(StrContainer& list)const
 {
+  if(isStatic()){
+    for (size_t i = 0; i < _table.size; i++)
+    {
+      list.push_back(_table.byVal[i].str);
+    }
+    return;
+  }
   for (IntToStrIt it = _intToStr.begin(); it != _intToStr.end(); it++)
   {
     list.push_back(it->second);
@@ -124,23 +318,55 @@ void EnumDictionary::getListStr(StrContainer& list)const
 
 void EnumDictionary::getListInts(IntContainer& list)const
 {
+  if(isStatic()){
+    for (size_t i = 0; i < _table.size; i++)
+    {
+      list.push_back(_table.byVal[i].val);
+    }
+    return;
+  }
   for (IntToStrIt it = _intToStr.begin(); it != _intToStr.end(); it++)
   {
     list.push_back(it->first);
   }
 }
 
-MEtl::string EnumDictionary::operator[](int val) const
+const MEtl::string& EnumDictionary::operator[](int val) const
 {
-  IntToStrIt it = _intToStr.find(val);
-  if(it != _intToStr.end()){
-    return it->second;
+  return (*this)(val);
+}
+
+const char* EnumDictionary::c_str(int val) const
+{
+  if(isStatic()){
+    return _table.str(val);
+  }
+  const MEtl::string& str = (*this)(val);
+  return (&str == &INVALID_STR_VAL) ? NULL : str.c_str();
+}
+
+void EnumDictionary::materialize() const
+{
+  for (size_t i = 0; i < _table.size; i++)
+  {
+    _staticIntToStr.insert(std::make_pair(_table.byVal[i].val, MEtl::string(_table.byVal[i].str)));
   }
-  return INVALID_STR_VAL;
 }
 
 const MEtl::string& EnumDictionary::operator()(int val) const
 {
+  if(isStatic()){
+    std::call_once(_materialized, &EnumDictionary::materialize, this);
+    IntToStrIt it = _staticIntToStr.find(val);
+    return (it != _staticIntToStr.end()) ? it->second : INVALID_STR_VAL;
+  }
+  if(!_dense.empty()){
+    size_t i = static_cast<size_t>(static_cast<long long>(val) - _denseMin);
+    if(i < _dense.size() && _dense[i]){
+      return *_dense[i];
+    }
+    return INVALID_STR_VAL;
+  }
   IntToStrIt it = _intToStr.find(val);
   if(it != _intToStr.end()){
     return it->second;
@@ -149,9 +375,81 @@ const MEtl::string& EnumDictionary::operator()(int val) const
 }
 
 int EnumDictionary::operator[](const MEtl::string& strVal) const{
+  if(isStatic()){
+    return _table.val(strVal.data(), strVal.size(), INVALID_VAL);
+  }
+  if(!_strSlots.empty()){
+    const StrSlot* slot = findStr(strVal);
+    return slot ? slot->val : INVALID_VAL;
+  }
   StrToIntIt it = _strToInt.find(strVal);
   if(it != _strToInt.end()){
     return it->second;
   }
   return INVALID_VAL;
 }
+
+size_t EnumDictionary::hashStr(const char* str, size_t len)
+{
+  //FNV-1a
+  uint64_t h = 14695981039346656037ull;
+  for (size_t i = 0; i < len; i++)
+  {
+    h = (h ^ static_cast<unsigned char>(str[i])) * 1099511628211ull;
+  }
+  return static_cast<size_t>(h);
+}
+
+void EnumDictionary::clearFrozen()
+{
+  _dense.clear();
+  _denseMin = 0;
+  _strSlots.clear();
+}
+
+void EnumDictionary::buildFrozen()
+{
+  clearFrozen();
+  if(_intToStr.empty()){
+    return;
+  }
+  long long minVal = _intToStr.begin()->first;
+  long long range = static_cast<long long>(_intToStr.rbegin()->first) - minVal + 1;
+  //a sparse enum would waste memory on the dense table, it keeps the map lookup
+  if(range <= static_cast<long long>(2 * _intToStr.size() + 16)){
+    _denseMin = static_cast<int>(minVal);
+    _dense.assign(static_cast<size_t>(range), NULL);
+    for (IntToStrIt it = _intToStr.begin(); it != _intToStr.end(); it++)
+    {
+      _dense[static_cast<size_t>(it->first - minVal)] = &it->second;
+    }
+  }
+
+  size_t capacity = 8;
+  while(capacity < 2 * _strToInt.size()){
+    capacity *= 2;
+  }
+  StrSlot empty = {NULL, INVALID_VAL};
+  _strSlots.assign(capacity, empty);
+  for (StrToIntIt it = _strToInt.begin(); it != _strToInt.end(); it++)
+  {
+    size_t i = hashStr(it->first.data(), it->first.size()) & (capacity - 1);
+    while(_strSlots[i].str){
+      i = (i + 1) & (capacity - 1);
+    }
+    _strSlots[i].str = &it->first;
+    _strSlots[i].val = it->second;
+  }
+}
+
+const EnumDictionary::StrSlot* EnumDictionary::findStr(const MEtl::string& strVal) const
+{
+  size_t mask = _strSlots.size() - 1;
+  for (size_t i = hashStr(strVal.data(), strVal.size()) & mask; _strSlots[i].str; i = (i + 1) & mask)
+  {
+    if(*_strSlots[i].str == strVal){
+      return &_strSlots[i];
+    }
+  }
+  return NULL;
+}
@@ -18,8 +18,159 @@
 #include "functionality/calibration/ContainerPropertyType.h"
 #include "functionality/calibration/ProperTypes.h"
 #include "basicTypes/MEtl/enumGenerator.h"
+#include "functionality/calibration/EpochDomain.h"
 #include <memory>
+#include <mutex>
+#include <type_traits>
 #include <limits.h>
+#include <stddef.h>
+
+//Compile-time enum tables.
+//An enum's int<->string table can be generated by the compiler into static storage instead of being built at runtime
+//from an IntToStr map:
+//
+//  static constexpr EnumEntry OLD_ENUM_ENTRIES[] = {ENUM_ENTRY(OLD_ENUM, FIRST_VALUE), ENUM_ENTRY(OLD_ENUM, SECOND_VALUE)};
+//  static constexpr StaticEnumTable<2> OLD_ENUM_TABLE(OLD_ENUM_ENTRIES);
+//  EnumDictionary::set(dictionary, OLD_ENUM_TABLE.view());
+//
+//ENUM_ENTRY works for plain enums and enum classes alike.
+struct EnumEntry
+{
+  int         val;
+  const char* str;
+};
+
+#define ENUM_ENTRY(ENUM, NAME) EnumEntry{static_cast<int>(ENUM::NAME), #NAME}
+
+namespace EnumTableDetail
+{
+constexpr size_t length(const char* str)
+{
+  size_t len = 0;
+  while(str[len] != '\0'){
+    len++;
+  }
+  return len;
+}
+
+//compares the len characters of a with the NUL terminated b
+constexpr int compare(const char* a, size_t len, const char* b)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    if(b[i] == '\0' || static_cast<unsigned char>(a[i]) > static_cast<unsigned char>(b[i])){
+      return 1;
+    }
+    if(static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i])){
+      return -1;
+    }
+  }
+  return b[len] == '\0' ? 0 : -1;
+}
+}
+
+//A type erased view of a StaticEnumTable; all lookups are constant-table lookups (binary search, or direct indexing
+//for contiguous enums) and can be evaluated at compile time.
+struct EnumTableView
+{
+  const EnumEntry* byVal; //sorted by val
+  const EnumEntry* byStr; //sorted by str
+  size_t           size;
+  bool             contiguous; //byVal[i].val == byVal[0].val + i
+
+  //returns NULL if val is not in the table
+  constexpr const char* str(int val) const
+  {
+    if(size == 0){
+      return NULL;
+    }
+    if(contiguous){
+      long long i = static_cast<long long>(val) - byVal[0].val;
+      return (i >= 0 && i < static_cast<long long>(size)) ? byVal[i].str : NULL;
+    }
+    size_t first = 0, last = size;
+    while(first < last){
+      size_t mid = first + (last - first) / 2;
+      if(byVal[mid].val < val){
+        first = mid + 1;
+      }
+      else{
+        last = mid;
+      }
+    }
+    return (first < size && byVal[first].val == val) ? byVal[first].str : NULL;
+  }
+
+  //returns invalid if str is not in the table
+  constexpr int val(const char* str, size_t len, int invalid) const
+  {
+    size_t first = 0, last = size;
+    while(first < last){
+      size_t mid = first + (last - first) / 2;
+      int cmp = EnumTableDetail::compare(str, len, byStr[mid].str);
+      if(cmp == 0){
+        return byStr[mid].val;
+      }
+      if(cmp > 0){
+        first = mid + 1;
+      }
+      else{
+        last = mid;
+      }
+    }
+    return invalid;
+  }
+};
+
+template<size_t N>
+class StaticEnumTable
+{
+public:
+  constexpr explicit StaticEnumTable(const EnumEntry (&entries)[N])
+  :_byVal(),
+   _byStr(),
+   _contiguous(true)
+  {
+    for (size_t i = 0; i < N; i++)
+    {
+      _byVal[i] = entries[i];
+      _byStr[i] = entries[i];
+    }
+    //insertion sort, N is small and this runs in the compiler
+    for (size_t i = 1; i < N; i++)
+    {
+      for (size_t j = i; j > 0 && _byVal[j].val < _byVal[j - 1].val; j--)
+      {
+        EnumEntry tmp = _byVal[j];
+        _byVal[j] = _byVal[j - 1];
+        _byVal[j - 1] = tmp;
+      }
+      for (size_t j = i; j > 0 && EnumTableDetail::compare(_byStr[j].str, EnumTableDetail::length(_byStr[j].str),
+                                                          _byStr[j - 1].str) < 0; j--)
+      {
+        EnumEntry tmp = _byStr[j];
+        _byStr[j] = _byStr[j - 1];
+        _byStr[j - 1] = tmp;
+      }
+    }
+    for (size_t i = 1; i < N; i++)
+    {
+      if(static_cast<long long>(_byVal[i].val) != static_cast<long long>(_byVal[0].val) + static_cast<long long>(i)){
+        _contiguous = false;
+      }
+    }
+  }
+
+  constexpr EnumTableView view() const
+  {
+    return EnumTableView{_byVal, _byStr, N, _contiguous};
+  }
+
+private:
+  EnumEntry _byVal[N];
+  EnumEntry _byStr[N];
+  bool      _contiguous;
+};
 
 class EnumDictionary
 {
@@ -31,7 +182,49 @@ public:
   typedef std::map<MEtl::string, int> StrToInt;
   typedef StrToInt::const_iterator    StrToIntIt;
   static void set(std::atomic<EnumDictionary*>& dictionary, const IntToStr& intToStr,bool freeze = true);
-  MEtl::string operator[](int val) const;
+  //Set a dictionary backed by a compile-time table (see StaticEnumTable). The table must have static storage.
+  //Such a dictionary is frozen; append() and reset() leave it unchanged.
+  static void set(std::atomic<EnumDictionary*>& dictionary, const EnumTableView& table);
+  //returns INVALID_STR_VAL if val is not in the dictionary; never copies. The string belongs to the dictionary and stays
+  //valid as long as the dictionary does.
+  const MEtl::string& operator[](int val) const;
+  //returns NULL if val is not in the dictionary; never allocates, also for a dictionary backed by a compile-time table
+  const char* c_str(int val) const;
+
+  //Dictionary ids: a compact handle of a dictionary slot, used by EnumValue instead of a reference.
+  //Registering the same slot again returns the same id; 0 is never a valid id.
+  const static unsigned int MAX_DICTIONARY_IDS = 4096;
+  static unsigned int registerId(std::atomic<EnumDictionary*>& dictionary);
+  //returns NULL for an unknown id or a registered slot that was not set yet; lock free
+  static const EnumDictionary* byId(unsigned int id);
+  static const std::atomic<EnumDictionary*>* slotById(unsigned int id);
+
+  //Versioned publication: the static append() and reset() below never modify a published dictionary. They copy it,
+  //change the copy and swap it into the slot; the replaced dictionary is retired to domain() and deleted once no
+  //Reader can see it anymore. Lookups through a Reader are lock free, and references returned by operator()(int)
+  //stay valid while the Reader lives.
+  //A slot updated this way must only be read through Reader (EnumValue and OptimizeEnumeration do): a raw pointer
+  //would keep referring to the replaced dictionary, which is deleted once no Reader can see it.
+  class Reader
+  {
+  public:
+    explicit Reader(const std::atomic<EnumDictionary*>* dictionary)
+    :_guard(domain()),
+     _dictionary(dictionary ? dictionary->load(std::memory_order_acquire) : NULL){}
+    Reader(Reader&& other) = default;
+
+    const EnumDictionary* get() const {return _dictionary;}
+    const EnumDictionary* operator->() const {return _dictionary;}
+    const EnumDictionary& operator*() const {return *_dictionary;}
+    explicit operator bool() const {return _dictionary != NULL;}
+  private:
+    EpochDomain::Guard    _guard;
+    const EnumDictionary* _dictionary;
+  };
+  static Reader read(const std::atomic<EnumDictionary*>& dictionary){return Reader(&dictionary);}
+  static void append(std::atomic<EnumDictionary*>& dictionary, const IntToStr& intToStr, bool freeze = false);
+  static void reset(std::atomic<EnumDictionary*>& dictionary);
+  static EpochDomain& domain();
 
   //Note . in this function can be malloc issue, because it return the value by reference and another user can clear this object
   //Still this function is necessary. If  you want to get the string value without allocating memory e.g in online after init
@@ -39,24 +232,72 @@ public:
   int   operator[](const MEtl::string& strVal) const;
   void  getListStr(StrContainer& list)const;
   void  getListInts(IntContainer& list)const;
+  //Deprecated, use the static append() and reset(). These publish an updated copy through the slot this dictionary
+  //was set in, like the static ones; this object itself is not changed, so re-read the slot (or use a Reader) to see
+  //the update. A dictionary replaced through them is never deleted: existing code may hold a raw pointer or reference
+  //to it, which keeps referring to the dictionary as it was before the update.
+  [[deprecated("use the static EnumDictionary::append(slot, intToStr, freeze)")]]
   void  append(const IntToStr& intToStr,bool freeze = false );
+  [[deprecated("use the static EnumDictionary::reset(slot)")]]
   void  reset();
   bool isFreeze() const;
 private:
-  EnumDictionary():_freeze(false){}
-  EnumDictionary(const EnumDictionary& other):_freeze(other._freeze){}
+  friend class OptimizeEnumeration;
+  //in place updates, only applied to the private copy made by update()
+  void  appendInPlace(const IntToStr& intToStr,bool freeze);
+  void  resetInPlace();
+  EnumDictionary():_freeze(false),_denseMin(0),_table(),_slot(NULL){}
+  EnumDictionary(const EnumDictionary& other):_freeze(other._freeze),_denseMin(0),_table(other._table),_slot(other._slot){}
   void operator= (const EnumDictionary& other){}
   void init(const IntToStr& intToStr,bool freeze);
+  EnumDictionary* clone() const;
+  //retire is false for the deprecated members: the replaced dictionary is kept, not retired
+  template<typename UPDATE>
+  static void update(std::atomic<EnumDictionary*>& dictionary, UPDATE updateCopy, bool retire);
+  static void appendTo(std::atomic<EnumDictionary*>& dictionary, const IntToStr& intToStr, bool freeze, bool retire);
+  static void resetTo(std::atomic<EnumDictionary*>& dictionary, bool retire);
+
+  //Frozen layout: once frozen the dictionary does not change, so lookups use flat tables pointing into _intToStr
+  //instead of walking the maps. _dense is indexed by val - _denseMin and is built only for compact ranges.
+  struct StrSlot
+  {
+    const MEtl::string* str; //NULL marks an empty slot
+    int                 val;
+  };
+  void buildFrozen();
+  void clearFrozen();
+  static size_t hashStr(const char* str, size_t len);
+  const StrSlot* findStr(const MEtl::string& strVal) const;
+
   IntToStr                               _startIntToStr;
   IntToStr                               _intToStr;
   StrToInt                               _strToInt;
   bool                                   _freeze;
+  std::vector<const MEtl::string*>       _dense;
+  int                                    _denseMin;
+  std::vector<StrSlot>                   _strSlots; //open addressing, size is a power of 2, load factor <= 1/2
+
+  //Static layout: the compile-time table answers all lookups. Only operator()(int), which returns a reference to a
+  //MEtl::string, needs the maps; they are materialized from the table on its first call.
+  bool isStatic() const {return _table.byVal != NULL;}
+  void materialize() const;
+  static void install(std::atomic<EnumDictionary*>& dictionary, EnumDictionary* newVal);
+  EnumTableView                          _table;
+  mutable IntToStr                       _staticIntToStr;
+  mutable std::once_flag                 _materialized;
+  std::atomic<EnumDictionary*>*          _slot; //the slot this dictionary is published in
 };
 
 
 class OptimizeEnumeration {
   friend OptimizeEnumeration& atot(OptimizeEnumeration& t, const MEtl::string& a);
 public:
+  //dictionary is the slot the dictionary is published in; every lookup reads the slot's current version.
+  //The slot must outlive the enumeration.
+  OptimizeEnumeration(int val,const std::atomic<EnumDictionary*>& dictionary);
+  //Deprecated, pass the slot instead. Looks up through the slot dictionary was set in, so it follows later updates
+  //of the slot as well; that slot must outlive the enumeration.
+  [[deprecated("pass the std::atomic<EnumDictionary*> slot of the dictionary")]]
   OptimizeEnumeration(int val,const EnumDictionary& dictionary);
   virtual ~OptimizeEnumeration();
   OptimizeEnumeration(const OptimizeEnumeration& other);
@@ -73,13 +314,47 @@ public:
   virtual bool operator >= (const OptimizeEnumeration& other) const{return _val >= other._val;}
 protected:
   int          _val;
-  const  EnumDictionary& _dictionary;
+  const  std::atomic<EnumDictionary*>& _dictionary;
 };
 
 OptimizeEnumeration& atot(OptimizeEnumeration& t, const MEtl::string& a);
 MEtl::string ttoa(const OptimizeEnumeration& t);
 const char* ttot(const OptimizeEnumeration& t);
 
+//A value-sized enumeration: the value and the id of its dictionary (see EnumDictionary::registerId).
+//Unlike OptimizeEnumeration it has no vptr and no reference member, it is trivially copyable and compares without
+//indirect calls, so it fits ProperT<T>, containers and sorting loops. The dictionary is only consulted to convert
+//to and from strings.
+class EnumValue
+{
+public:
+  EnumValue() = default;
+  constexpr EnumValue(int val, unsigned int dictionaryId):_val(val),_dictionaryId(dictionaryId){}
+
+  constexpr operator int() const {return _val;}
+  constexpr unsigned int dictionaryId() const {return _dictionaryId;}
+  const EnumDictionary* dictionary() const {return EnumDictionary::byId(_dictionaryId);}
+
+  constexpr bool operator == (const EnumValue& other) const{return _val == other._val;}
+  constexpr bool operator != (const EnumValue& other) const{return _val != other._val;}
+  constexpr bool operator < (const  EnumValue& other) const{return _val <  other._val;}
+  constexpr bool operator <= (const EnumValue& other) const{return _val <= other._val;}
+  constexpr bool operator > (const  EnumValue& other) const{return _val >  other._val;}
+  constexpr bool operator >= (const EnumValue& other) const{return _val >= other._val;}
+private:
+  friend EnumValue& atot(EnumValue& t, const MEtl::string& a);
+  int          _val          = EnumDictionary::INVALID_VAL;
+  unsigned int _dictionaryId = 0;
+};
+
+static_assert(std::is_trivially_copyable<EnumValue>::value, "EnumValue must stay trivially copyable");
+static_assert(sizeof(EnumValue) == 2 * sizeof(int), "EnumValue must stay value sized");
+
+//the dictionary id of t is kept, only the value is parsed
+EnumValue& atot(EnumValue& t, const MEtl::string& a);
+MEtl::string ttoa(const EnumValue& t);
+const char* ttot(const EnumValue& t);
+
 
 
 #endif /* FUNCTIONALITY_CALIBRATION_ENUMERATIONPROPERTYPES_H_ */
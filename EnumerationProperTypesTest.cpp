@@ -0,0 +1,150 @@
+/**
+ * @file EnumerationProperTypesTest.cpp
+ * @brief Tests of the versioned EnumDictionary: updates publish a copy, readers keep the version they hold, and the
+ *        deprecated members and constructor follow the slot.
+ */
+
+#include "EnumerationProperTypes.h"
+
+#include <stdio.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+EnumDictionary::IntToStr entry(int val, const char* str) {
+  EnumDictionary::IntToStr intToStr;
+  intToStr[val] = str;
+  return intToStr;
+}
+
+void testCopyOnWrite() {
+  std::atomic<EnumDictionary*> slot(nullptr);
+  EnumDictionary::set(slot, entry(1, "ONE"), false);
+  EnumDictionary::Reader before = EnumDictionary::read(slot);
+  const MEtl::string& one = (*before)(1);
+
+  EnumDictionary::append(slot, entry(2, "TWO"));
+  // the held version is unchanged and its references stay valid
+  CHECK((*before)[2] == EnumDictionary::INVALID_STR_VAL);
+  CHECK(one == "ONE");
+  EnumDictionary::Reader after = EnumDictionary::read(slot);
+  CHECK(after.get() != before.get());
+  CHECK((*after)[2] == "TWO");
+  CHECK((*after)[MEtl::string("ONE")] == 1);
+
+  EnumDictionary::reset(slot);
+  EnumDictionary::Reader reset = EnumDictionary::read(slot);
+  CHECK((*reset)[2] == EnumDictionary::INVALID_STR_VAL);
+  CHECK((*reset)[1] == "ONE");
+  CHECK((*after)[2] == "TWO");
+}
+
+void testFreeze() {
+  std::atomic<EnumDictionary*> slot(nullptr);
+  EnumDictionary::set(slot, entry(1, "ONE"), false);
+  EnumDictionary::append(slot, entry(2, "TWO"), true);
+  // a frozen dictionary ignores further updates
+  EnumDictionary::append(slot, entry(3, "THREE"));
+  EnumDictionary::Reader reader = EnumDictionary::read(slot);
+  CHECK(reader->isFreeze());
+  CHECK((*reader)[MEtl::string("TWO")] == 2);
+  CHECK((*reader)[MEtl::string("THREE")] == EnumDictionary::INVALID_VAL);
+  CHECK(std::string(reader->c_str(1)) == "ONE");
+  CHECK(reader->c_str(3) == nullptr);
+}
+
+void testConcurrentUpdates() {
+  std::atomic<EnumDictionary*> slot(nullptr);
+  EnumDictionary::set(slot, entry(0, "ZERO"), false);
+  std::atomic<bool> done(false);
+  std::atomic<int> wrong(0);
+  std::thread reader([&]() {
+    while (!done.load()) {
+      EnumDictionary::Reader current = EnumDictionary::read(slot);
+      if ((*current)(0) != "ZERO" || (*current)[MEtl::string("ZERO")] != 0) {
+        ++wrong;
+      }
+    }
+  });
+  // two writers: every update is applied to the latest version, none is lost
+  std::thread writer([&]() {
+    for (int i = 1000; i < 1500; ++i) {
+      EnumDictionary::append(slot, entry(i, ("V" + std::to_string(i)).c_str()));
+    }
+  });
+  for (int i = 1; i < 500; ++i) {
+    EnumDictionary::append(slot, entry(i, ("V" + std::to_string(i)).c_str()));
+  }
+  writer.join();
+  done = true;
+  reader.join();
+  CHECK(wrong == 0);
+  EnumDictionary::Reader last = EnumDictionary::read(slot);
+  CHECK((*last)[499] == "V499");
+  CHECK((*last)[1499] == "V1499");
+  CHECK((*last)[MEtl::string("V7")] == 7);
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+void testDeprecated() {
+  std::atomic<EnumDictionary*> slot(nullptr);
+  EnumDictionary::set(slot, entry(1, "ONE"), false);
+  EnumDictionary* raw = slot.load();
+  OptimizeEnumeration enumeration(1, *raw);
+
+  // the member append() publishes through the slot and leaves the object it was called on as it was
+  raw->append(entry(2, "TWO"));
+  CHECK((*raw)[2] == EnumDictionary::INVALID_STR_VAL);
+  CHECK((*slot.load())[2] == "TWO");
+  // the enumeration made from the object follows the slot
+  CHECK(enumeration[2] == "TWO");
+  CHECK(enumeration[MEtl::string("TWO")] == 2);
+
+  slot.load()->reset();
+  CHECK(enumeration[2] == EnumDictionary::INVALID_STR_VAL);
+  EnumDictionary::append(slot, entry(2, "TWO"));
+  CHECK(enumeration[2] == "TWO");
+  // a dictionary replaced through the deprecated members is kept, raw pointers to it stay valid
+  CHECK((*raw)[1] == "ONE");
+}
+#pragma GCC diagnostic pop
+
+void testOptimizeEnumeration() {
+  std::atomic<EnumDictionary*> slot(nullptr);
+  EnumDictionary::set(slot, entry(1, "ONE"), false);
+  OptimizeEnumeration enumeration(1, slot);
+  CHECK(static_cast<int>(enumeration) == 1);
+  CHECK(ttoa(enumeration) == "ONE");
+  EnumDictionary::append(slot, entry(2, "TWO"));
+  atot(enumeration, MEtl::string("TWO"));
+  CHECK(static_cast<int>(enumeration) == 2);
+  CHECK(ttoa(enumeration) == "TWO");
+}
+}// namespace
+
+int main() {
+  testCopyOnWrite();
+  testFreeze();
+  testConcurrentUpdates();
+  testDeprecated();
+  testOptimizeEnumeration();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file EpochDomain.cpp
+ */
+
+#include "EpochDomain.h"
+
+EpochDomain::EpochDomain()
+    : _epoch(2) {
+  _readers[0] = 0;
+  _readers[1] = 0;
+}
+
+EpochDomain::~EpochDomain() {
+  for (size_t i = 0; i < _retired.size(); ++i) {
+    _retired[i].deleter(_retired[i].object);
+  }
+}
+
+uint64_t EpochDomain::enter() {
+  uint64_t epoch = _epoch.load();
+  _readers[epoch & 1].fetch_add(1);
+  // a reader counted under a newer epoch of the same parity only loads pointers published in that newer epoch
+  return epoch;
+}
+
+void EpochDomain::leave(uint64_t epoch) {
+  _readers[epoch & 1].fetch_sub(1);
+}
+
+bool EpochDomain::tryAdvance() {
+  uint64_t epoch = _epoch.load();
+  // readers may only be in the current or the previous epoch; the previous one must drain before advancing
+  if (_readers[(epoch - 1) & 1].load() != 0) {
+    return false;
+  }
+  return _epoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+void EpochDomain::retire(void* object, Deleter deleter) {
+  {
+    std::lock_guard<std::mutex> lock(_retiredMutex);
+    Retired retired;
+    retired.object = object;
+    retired.deleter = deleter;
+    retired.epoch = _epoch.load();
+    _retired.push_back(retired);
+  }
+  reclaim();
+}
+
+void EpochDomain::reclaim() {
+  std::vector<Retired> ready;
+  {
+    std::lock_guard<std::mutex> lock(_retiredMutex);
+    tryAdvance();
+    tryAdvance();
+    uint64_t epoch = _epoch.load();
+    size_t kept = 0;
+    for (size_t i = 0; i < _retired.size(); ++i) {
+      if (_retired[i].epoch + 2 <= epoch) {
+        ready.push_back(_retired[i]);
+      }
+      else {
+        _retired[kept++] = _retired[i];
+      }
+    }
+    _retired.resize(kept);
+  }
+  for (size_t i = 0; i < ready.size(); ++i) {
+    ready[i].deleter(ready[i].object);
+  }
+}
+
+size_t EpochDomain::pending() const {
+  std::lock_guard<std::mutex> lock(_retiredMutex);
+  return _retired.size();
+}
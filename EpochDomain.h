@@ -0,0 +1,102 @@
+/**
+ * @file EpochDomain.h
+ */
+
+#ifndef __EPOCH_DOMAIN__H__
+#define __EPOCH_DOMAIN__H__
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class EpochDomain
+ * @brief Epoch based deferred reclamation for objects published through atomic pointers.
+ *
+ * Readers enter the domain (Guard) before loading a published pointer and leave it when they are done with the object.
+ * Entering and leaving are a single atomic increment/decrement each, so readers are wait-free.
+ *
+ * A writer that replaced a published pointer retires the old object instead of deleting it. Retired objects are
+ * deleted once every reader that could still see them has left: the global epoch only advances when the readers of
+ * the previous epoch have drained, so an object retired in epoch E is unreachable from epoch E + 2 on. Reclamation
+ * never blocks; it is attempted on every retire() and reclaim() call.
+ */
+class EpochDomain {
+public:
+  /// @brief RAII reader registration; objects loaded while the guard lives stay valid until it is destroyed.
+  class Guard {
+  public:
+    explicit Guard(EpochDomain& domain)
+        : _domain(&domain)
+        , _epoch(domain.enter()) {}
+    Guard(Guard&& other)
+        : _domain(other._domain)
+        , _epoch(other._epoch) {
+      other._domain = nullptr;
+    }
+    ~Guard() {
+      if (_domain) {
+        _domain->leave(_epoch);
+      }
+    }
+
+  private:
+    Guard(const Guard& other);
+    Guard& operator=(const Guard& other);
+
+    EpochDomain* _domain;
+    uint64_t _epoch;
+  };
+
+  EpochDomain();
+
+  /// @brief Deletes all retired objects. No reader may be inside the domain anymore.
+  ~EpochDomain();
+
+  /**
+   * @brief Retire an object that is no longer reachable by new readers.
+   *
+   * @tparam T The type of the object, deleted with `delete`.
+   * @param[in] object The object to retire (nullptr is ignored).
+   */
+  template<typename T>
+  void retire(const T* object) {
+    if (object) {
+      retire(const_cast<T*>(object), &EpochDomain::destroy<T>);
+    }
+  }
+
+  /// @brief Delete the retired objects that no reader can see anymore.
+  void reclaim();
+
+  /// @brief The number of retired objects not deleted yet.
+  size_t pending() const;
+
+  uint64_t enter();
+  void leave(uint64_t epoch);
+
+private:
+  typedef void (*Deleter)(void*);
+  struct Retired {
+    void* object;
+    Deleter deleter;
+    uint64_t epoch;
+  };
+
+  template<typename T>
+  static void destroy(void* object) {
+    delete static_cast<T*>(object);
+  }
+
+  void retire(void* object, Deleter deleter);
+  bool tryAdvance();
+
+  std::atomic<uint64_t> _epoch;
+  std::atomic<int64_t> _readers[2];
+  mutable std::mutex _retiredMutex; /** < Serializes writers only, readers never take it.*/
+  std::vector<Retired> _retired;
+};
+
+#endif//__EPOCH_DOMAIN__H__
@@ -0,0 +1,153 @@
+/**
+ * @file EpochDomainTest.cpp
+ * @brief Tests of EpochDomain: retired objects are deleted only once no reader that could see them is left.
+ */
+
+#include "EpochDomain.h"
+
+#include <stdio.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+const unsigned int ALIVE = 0xA11FE;
+
+std::atomic<int> g_live(0);
+
+struct Tracked {
+  explicit Tracked(int val)
+      : value(val)
+      , magic(ALIVE) {
+    ++g_live;
+  }
+  ~Tracked() {
+    magic = 0;
+    --g_live;
+  }
+  int value;
+  unsigned int magic;
+};
+
+void testNoReaders() {
+  EpochDomain domain;
+  domain.retire(new Tracked(1));
+  // nobody can see the object, so retiring deletes it right away
+  CHECK(domain.pending() == 0);
+  CHECK(g_live == 0);
+  domain.retire(static_cast<const Tracked*>(nullptr));
+  CHECK(domain.pending() == 0);
+}
+
+void testReaderHoldsBack() {
+  EpochDomain domain;
+  {
+    EpochDomain::Guard guard(domain);
+    domain.retire(new Tracked(1));
+    domain.reclaim();
+    CHECK(domain.pending() == 1);
+    CHECK(g_live == 1);
+  }
+  domain.reclaim();
+  CHECK(domain.pending() == 0);
+  CHECK(g_live == 0);
+}
+
+void testLaterReaderDoesNotHoldBack() {
+  EpochDomain domain;
+  EpochDomain::Guard* early = new EpochDomain::Guard(domain);
+  domain.retire(new Tracked(1));
+  // a reader entering after the retire cannot see the object
+  EpochDomain::Guard late(domain);
+  delete early;
+  domain.reclaim();
+  CHECK(domain.pending() == 0);
+  CHECK(g_live == 0);
+}
+
+void testMovedGuard() {
+  EpochDomain domain;
+  EpochDomain::Guard* moved = nullptr;
+  {
+    EpochDomain::Guard guard(domain);
+    moved = new EpochDomain::Guard(std::move(guard));
+  }
+  domain.retire(new Tracked(1));
+  CHECK(domain.pending() == 1);
+  delete moved;
+  domain.reclaim();
+  CHECK(domain.pending() == 0);
+}
+
+void testDestructor() {
+  {
+    EpochDomain domain;
+    EpochDomain::Guard* guard = new EpochDomain::Guard(domain);
+    domain.retire(new Tracked(1));
+    domain.retire(new Tracked(2));
+    CHECK(g_live == 2);
+    delete guard;
+  }
+  CHECK(g_live == 0);
+}
+
+void testConcurrentReaders() {
+  EpochDomain domain;
+  std::atomic<const Tracked*> published(new Tracked(0));
+  std::atomic<bool> done(false);
+  std::atomic<int> corrupted(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.push_back(std::thread([&]() {
+      int last = 0;
+      while (!done.load()) {
+        EpochDomain::Guard guard(domain);
+        const Tracked* current = published.load();
+        // a published object stays alive while the guard lives, and values are published in order
+        if (current->magic != ALIVE || current->value < last) {
+          ++corrupted;
+        }
+        last = current->value;
+      }
+    }));
+  }
+  for (int i = 1; i <= 20000; ++i) {
+    domain.retire(published.exchange(new Tracked(i)));
+  }
+  done = true;
+  for (size_t r = 0; r < readers.size(); ++r) {
+    readers[r].join();
+  }
+  CHECK(corrupted == 0);
+  domain.retire(published.exchange(nullptr));
+  domain.reclaim();
+  CHECK(domain.pending() == 0);
+  CHECK(g_live == 0);
+}
+}// namespace
+
+int main() {
+  testNoReaders();
+  testReaderHoldsBack();
+  testLaterReaderDoesNotHoldBack();
+  testMovedGuard();
+  testDestructor();
+  testConcurrentReaders();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -8,19 +8,32 @@
 #include "basicTypes/MEtl/string.h"
 #include <assert.h>
 
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
+#include <string_view>
+#include <typeinfo>
 #include <vector>
 
 #include "ProperTypes.h"
+#include "PropertiesArena.h"
+#include "PropertiesConvert.h"
+#include "PropertiesIndex.h"
+#include "PropertiesPresets.h"
+#include "PropertiesSnapshot.h"
 
 class boolshit;
 class PropertiesManager;
 class Properties;
 class MetaProperties;
 class PropertyVerification;
+class IniTokenizer;
+class PropertiesSectionIndex;
+class PropertiesCommandLine;
+class PropertiesEnvironment;
 
 enum VerificationStatus_e {
   E_VERIFICATION_SUCCEEDED = 0,
@@ -39,6 +52,20 @@ enum InputStringValidityCheckPolicy {
   CHECK_INPUT_STRING_VALIDITY = 1
 };
 
+/**
+ * @brief Identifies a binary value type without RTTI.
+ *
+ * PropertyTypeTag<T>::id() returns a distinct address per type T. It is used to ask a Property for its binary value
+ * of a given type (see Property::typedValue()).
+ */
+template<typename T>
+struct PropertyTypeTag {
+  static const void* id() {
+    static const char tag = 0;
+    return &tag;
+  }
+};
+
 enum ValidatorType {
   DEFAULT_VALIDATOR,
   DISCRETE_ITEMS_VALIDATOR,
@@ -146,6 +173,7 @@ public:
   Property(Properties* container_, const char* name_, const char* desc_, int flags_, bool tboolshit_, void* data_,
            const VALIDATOR& validator_, bool mandatory_ = false)
       : _container(container_)
+      , _slot(PropertiesIndex::NPOS)
       , name(name_)
       , desc(desc_)
       , flags(flags_)
@@ -153,9 +181,10 @@ public:
       , modified(false)
       , tboolshit(tboolshit_)
       , mandatory(mandatory_)
-      , _ownsValidator(true)
+      , _ownsValidator(!arenaOf(container_))
       , data(data_)
-      , _validator(new VALIDATOR(validator_)) {}
+      , _validator(newValidator(container_, validator_))
+      , _copyValidator(&Property::copyValidator<VALIDATOR>) {}
 
   /**
    * @brief Construct a Property.
@@ -174,6 +203,7 @@ public:
   Property(Properties* container_, const char* name_, const char* desc_, int flags_, bool tboolshit_, void* data_,
            const Validator* validator_, bool mandatory_ = false)
       : _container(container_)
+      , _slot(PropertiesIndex::NPOS)
       , name(name_)
       , desc(desc_)
       , flags(flags_)
@@ -183,7 +213,8 @@ public:
       , mandatory(mandatory_)
       , _ownsValidator(false)
       , data(data_)
-      , _validator(validator_) {}
+      , _validator(validator_)
+      , _copyValidator(nullptr) {}
 
   /**
    * @brief Construct a Property without a validator.
@@ -201,6 +232,7 @@ public:
   Property(Properties* container_, const char* name_, const char* desc_, int flags_, bool tboolshit_,
            bool mandatory_ = false)
       : _container(container_)
+      , _slot(PropertiesIndex::NPOS)
       , name(name_)
       , desc(desc_)
       , flags(flags_)
@@ -210,20 +242,17 @@ public:
       , mandatory(mandatory_)
       , _ownsValidator(false)
       , data(nullptr)
-      , _validator(nullptr) {}
+      , _validator(nullptr)
+      , _copyValidator(nullptr) {}
 
   /**
    * @brief Destructor for the Property object.
    *
    * The destructor releases any resources associated with the Property object. If the property owns a validator,
    * it is properly deallocated. This ensures that all memory allocated for the property's resources is properly managed.
+   * The property is unregistered from its container's index, which keeps the value.
    */
-  virtual ~Property() {
-    if (_ownsValidator && _validator) {
-      delete _validator;
-      _validator = nullptr;
-    }
-  }
+  virtual ~Property();
 
   /**
    * @brief Set a custom validator for property value validation.
@@ -236,8 +265,9 @@ public:
     if (_ownsValidator) {
       delete _validator;
     }
-    _ownsValidator = true;
-    _validator = new VALIDATOR(validator);
+    _ownsValidator = !arenaOf(_container);
+    _validator = newValidator(_container, validator);
+    _copyValidator = &Property::copyValidator<VALIDATOR>;
   }
 
   /**
@@ -251,6 +281,7 @@ public:
     }
     _ownsValidator = false;
     _validator = validator;
+    _copyValidator = nullptr;
   }
 
   /**
@@ -271,7 +302,8 @@ public:
   }
 
 protected:
-  Properties* _container; /** < Pointer to the container of properties to which this property belongs. */
+  Properties* _container;               /** < Pointer to the container of properties to which this property belongs. */
+  mutable PropertiesIndex::Slot _slot; /** < Cached slot of this property in its container's index (see slot()). */
 public:
   const char* const name;      /** < The name of the property. */
   const char* const desc;      /** < The description of the property. */
@@ -283,6 +315,12 @@ public:
   bool _ownsValidator;         /** < Indicates whether the property owns its validator. */
   void* data;                  /** < Pointer to additional data associated with the property. */
   const Validator* _validator; /** < Pointer to the validator for property value validation. */
+
+private:
+  typedef const Validator* (*ValidatorCopier)(Properties* container, const Validator& validator);
+  ValidatorCopier _copyValidator; /** < Copies a validator set by type, nullptr for a validator set by pointer. */
+
+public:
   virtual void sync(const MEtl::string& val) const = 0;
   bool updated() const;
   virtual const char* type() const = 0;
@@ -341,6 +379,117 @@ public:
   virtual void handleValue(const char* fileName, const char* sectionName) const = 0;
 
   virtual Properties* getContainer() const = 0;
+
+  /**
+   * @brief Get the binary value of the property if it is of the requested type.
+   *
+   * @param[in] typeTag PropertyTypeTag<T>::id() of the requested type.
+   * @return A pointer to the binary value, or nullptr if the property does not hold a value of that type.
+   */
+  virtual const void* typedValue(const void* typeTag) const { return nullptr; }
+
+  /**
+   * @brief Set the binary value of the property if it is of the given type, without parsing any text.
+   *        The caller keeps the value text of the container consistent (@see Properties::loadBinary()).
+   *
+   * @param[in] typeTag PropertyTypeTag<T>::id() of the type of val.
+   * @param[in] val Pointer to the new value.
+   * @return true if the property is of that type and was set.
+   */
+  virtual bool assignTypedValue(const void* typeTag, const void* val) const { return false; }
+
+protected:
+  PropertiesIndex::Slot slot() const;
+  bool isSynced(const MEtl::string& val) const;
+  void markSynced(const MEtl::string& val) const;
+
+  /**
+   * @brief Typed set path (@see Properties::enableTypedSet()): typedSetSlot() returns the slot of the property if its
+   *        container enabled the path, NPOS otherwise. setTyped() validates and stores the formatted value as
+   *        setProperty() does, but calls assign() to set the binary value instead of parsing the stored text back.
+   */
+  PropertiesIndex::Slot typedSetSlot() const;
+  template<typename ASSIGN>
+  bool setTyped(PropertiesIndex::Slot slot, const MEtl::string& val, ASSIGN assign) const;
+
+  /// @brief Validator copies are placed in the container's arena if it has one, the arena then owns them.
+  static PropertiesArena* arenaOf(Properties* container);
+  template<typename VALIDATOR>
+  static const Validator* newValidator(Properties* container, const VALIDATOR& validator) {
+    PropertiesArena* arena = arenaOf(container);
+    if (arena) {
+      return arena->create<VALIDATOR>(validator);
+    }
+    PropertiesArena::countHeapAllocation();
+    return new VALIDATOR(validator);
+  }
+  template<typename VALIDATOR>
+  static const Validator* copyValidator(Properties* container, const Validator& validator) {
+    return newValidator(container, static_cast<const VALIDATOR&>(validator));
+  }
+
+  /// @brief A validator copy placed in the previous container's arena dies with that container, so it is copied again.
+  void rehomeValidator(Properties* container);
+};
+
+/**
+ * @class PropertyKey
+ * @brief A property key together with its hash.
+ *
+ * When constructed from a string literal the hash is computed at compile time, e.g.
+ * @code
+ *   static constexpr PropertyKey kGain("gain");
+ * @endcode
+ * The key text is referenced, not copied, so the string must outlive the PropertyKey.
+ */
+class PropertyKey {
+public:
+  template<size_t N>
+  constexpr PropertyKey(const char (&key)[N])
+      : _key(key)
+      , _len(N - 1)
+      , _hash(PropertiesIndex::hash(key, N - 1)) {}
+
+  PropertyKey(const MEtl::string& key)
+      : _key(key.c_str())
+      , _len(key.size())
+      , _hash(PropertiesIndex::hash(key.c_str(), key.size())) {}
+
+  constexpr const char* c_str() const { return _key; }
+  constexpr size_t size() const { return _len; }
+  constexpr uint64_t hash() const { return _hash; }
+
+private:
+  const char* _key;
+  size_t _len;
+  uint64_t _hash;
+};
+
+/**
+ * @class PropertyHandle
+ * @brief A key resolved once to its slot in a Properties container.
+ *
+ * A handle is obtained from Properties::handle() and gives O(1) access to the key through getProperty()/setProperty()
+ * without hashing or comparing the key text again. Slots are never moved or removed, so a handle stays valid for the
+ * lifetime of its container, including across reloadPresets() and loadCanonical().
+ */
+class PropertyHandle {
+public:
+  PropertyHandle()
+      : _container(nullptr)
+      , _slot(PropertiesIndex::NPOS) {}
+
+  bool valid() const { return _container != nullptr; }
+  const Properties* container() const { return _container; }
+
+private:
+  friend class Properties;
+  PropertyHandle(const Properties* container, PropertiesIndex::Slot slot)
+      : _container(container)
+      , _slot(slot) {}
+
+  const Properties* _container;
+  PropertiesIndex::Slot _slot;
 };
 
 /**
@@ -435,6 +584,18 @@ public:
 
   bool load(char** env);
 
+  /**
+   * @brief Load properties from indexed environment variables named "<prefix><key>".
+   *        The variables are found with a binary search of the index (@see PropertiesEnvironment::process() for the
+   *        process environment) instead of a scan of the environment. Properties source will be marked as
+   *        Property::FROM_ENV. Invokes onLoaded() and postLoaded() methods.
+   *
+   * @param[in] environment The indexed environment.
+   * @param[in] prefix The name prefix of the variables of this object; it is removed to get the property key.
+   * @return true If all properties were loaded successfully.
+   */
+  bool load(const PropertiesEnvironment& environment, std::string_view prefix);
+
   /**
    * @brief Load properties from the provided vector. Each element in the vector should follow the format: "key=value".
    *        If an invalid string is encountered, such as one with an incorrect format or a key name that doesn't
@@ -513,6 +674,25 @@ public:
    */
   bool load(const Strings& strings, char sep, const char* section, unsigned int source = Property::FROM_INF);
 
+  /**
+   * @brief Load properties of the specified section from an already indexed INI buffer.
+   *        The section data is found with a single lookup in the index instead of rescanning the buffer, so loading
+   *        many Properties objects from one buffer costs a single scan (building the index).
+   *        For more details @see load(std::istream &inStream, char sep, const char *section = nullptr,
+   *        unsigned int source = Property::FROM_INF)
+   *
+   * @param[in] index The section index of the buffer containing properties.
+   * @param[in] sep The character used as the separator between keys and values of properties in the buffer.
+   * @param[in] section The section whose properties should be loaded. Default is nullptr, meaning all sections of the
+   *                    buffer, as with the other loads; pass getName().c_str() to load the section of this object.
+   * @param[in] source The source of the buffer. Optional; default source is Property::FROM_INF.
+   * @return true If all properties from the given section were loaded successfully, or the section does not exist
+   *              (@see getLastLoadCallSectionFound()).
+   * @return false If loading a property from the section was unsuccessful.
+   */
+  bool load(const PropertiesSectionIndex& index, char sep, const char* section = nullptr,
+            unsigned int source = Property::FROM_INF);
+
   /**
    * @brief Load properties from the provided string based on the specified section, without checking their validity.
    *        For more details @see load(std::istream &inStream, char sep, const char *section = nullptr,
@@ -544,6 +724,19 @@ public:
    */
   bool load(int argc, char* argv[], const char* section = nullptr);
 
+  /**
+   * @brief Load properties from a command line indexed once for all Properties objects.
+   *        Same as load(int argc, char* argv[], const char* section), without converting the command line to text:
+   *        the properties of the section are found with a single lookup and applied directly.
+   *
+   * @param[in] commandLine The indexed command line.
+   * @param[in] section The section whose properties should be loaded, with or without brackets; nullptr (the
+   *                    default) for all properties.
+   * @return true If all properties from the given section were loaded successfully.
+   * @return false If loading a property from the section was unsuccessful.
+   */
+  bool load(const PropertiesCommandLine& commandLine, const char* section = nullptr);
+
   /**
    * @brief Load properties from the given file based on the specified section.
    *        For more details @see load(std::istream &inStream, char sep, const char *section = nullptr,
@@ -591,6 +784,89 @@ public:
   bool loadFile(const Strings& multiFile, char sep, const char* section = nullptr,
                 unsigned int source = Property::FROM_INF);
 
+  /// @brief Per file timings of loadFile(const Strings&, char, const char*, unsigned int, unsigned int, ...).
+  struct FileLoadTiming {
+    MEtl::string file; /** < The path of the file.*/
+    double readMs;     /** < Time spent opening and mapping the file.*/
+    double tokenizeMs; /** < Time spent tokenizing the file.*/
+    double applyMs;    /** < Time spent applying the file's records to this object.*/
+    size_t records;    /** < The number of records of the requested section in the file.*/
+    bool ok;           /** < Whether the file was read and all its records were loaded successfully.*/
+  };
+
+  /**
+   * @brief Load properties from the given group of files, reading and tokenizing the files concurrently.
+   *        The files are read and tokenized on up to `threads` threads. Their records are then applied to this object
+   *        in the order of `multiFile`, so properties of later files override those of earlier files, exactly as with
+   *        the sequential loadFile(const Strings&, char, const char*, unsigned int).
+   *        Invokes onLoaded() and postLoaded() methods once, after all files were applied.
+   *        With verbosity MID or higher the per file timings are printed to the output stream.
+   *
+   * @param[in] multiFile The collection of paths to the files containing properties.
+   * @param[in] sep The character used as the separator between keys and values of properties in the files.
+   * @param[in] section The section from the files whose properties should be loaded, nullptr for all properties.
+   * @param[in] source The source of the loaded properties.
+   * @param[in] threads The maximal number of reader threads, 0 for the number of hardware threads.
+   * @param[out] timings If not nullptr, receives the timings of every file, in the order of `multiFile`.
+   * @return true If all files were read and all properties were loaded successfully.
+   * @return false If a file could not be read or loading a property was unsuccessful.
+   */
+  bool loadFile(const Strings& multiFile, char sep, const char* section, unsigned int source, unsigned int threads,
+                std::vector<FileLoadTiming>* timings = nullptr);
+
+  /**
+   * @brief Load the given file into several Properties objects in a single pass.
+   *        The file is memory mapped and tokenized once, without copying it into a string. Every record is routed to
+   *        the objects whose section name (@see getName()) matches the record's section; objects with an empty section
+   *        name receive the sectionless records. Keys unknown to an object go through its unknown fields policy and
+   *        are then kept as free parameters with the given source, as load() keeps them.
+   *        Invokes onLoaded() and postLoaded() methods of every object whose section was found.
+   *
+   * @param[in] file The path to the file containing properties, organized into sections following the described format.
+   * @param[in] sep The character used as the separator between keys and values of properties in the file.
+   * @param[in] containers The Properties objects to load.
+   * @param[in] source The source of the properties loaded. Optional; default source is Property::FROM_INF.
+   * @return true If the file was read and all routed properties were loaded successfully.
+   * @return false If the file could not be read or loading a property was unsuccessful.
+   */
+  static bool loadFile(const char* file, char sep, const std::vector<Properties*>& containers,
+                       unsigned int source = Property::FROM_INF);
+
+  /**
+   * @brief Load this Properties object from a binary snapshot written by storeBinary().
+   *        The file is memory mapped and its header, bounds and checksum are verified before any value is applied.
+   *        Values are validated as if loaded from text; the stored binary value of a scalar property is assigned
+   *        directly, so only string values are parsed. Invokes onLoaded() and postLoaded() methods if the section
+   *        was found.
+   *
+   * @param[in] file The path of the binary file.
+   * @param[out] errMsg Receives the reason of a failure.
+   * @param[in] source The source of the properties loaded. Optional; default source is Property::FROM_INF.
+   * @param[in] checksums Optional list of valid checksums; the loaded values are checked by validateChecksum(),
+   *                      exactly as after a text load.
+   * @return true If the file is valid and all properties were loaded successfully.
+   */
+  bool loadBinary(const MEtl::string& file, MEtl::string& errMsg, unsigned int source = Property::FROM_INF,
+                  const UInts* checksums = nullptr);
+
+  /**
+   * @brief Load several Properties objects from a binary snapshot; each object loads the section of its name.
+   *
+   * @see loadBinary(const MEtl::string&, MEtl::string&, unsigned int, const UInts*)
+   */
+  static bool loadBinary(const char* file, const std::vector<Properties*>& containers, MEtl::string& errMsg,
+                         unsigned int source = Property::FROM_INF, const UInts* checksums = nullptr);
+
+  /**
+   * @brief Store the values of this Properties object into a versioned binary snapshot (@see PropertiesBinary).
+   *        All values are stored, with their loaded bits and, for synced scalar properties, their binary value.
+   *
+   * @param[in] file The path of the binary file; it is replaced atomically.
+   * @param[out] errMsg Receives the reason of a failure.
+   * @return true If the file was written.
+   */
+  bool storeBinary(const MEtl::string& file, MEtl::string& errMsg) const;
+
   bool loadCanonical(const std::map<MEtl::string, MEtl::string>& propertiesMap);
 
   virtual void defaultCalibValues(){};
@@ -631,6 +907,35 @@ public:
   bool storeString(MEtl::string& data, char sep, const char* section = nullptr,
                    int flags = Properties::STORE_ALL_PERSISTENT);
 
+  /**
+   * @brief Get the exact number of bytes storeBuffer() writes for the same arguments (excluding a terminating NUL).
+   *        Use it to size the buffer passed to storeBuffer() once, e.g. at startup for crash report dumps.
+   *
+   * @param[in] sep The separator character used between key and value.
+   * @param[in] section The section under which properties are stored (default: nullptr).
+   * @param[in] flags Flags indicating the storage behavior, @see StoreOptions.
+   * @return The number of bytes required.
+   */
+  size_t storedSize(char sep, const char* section = nullptr, int flags = Properties::STORE_ALL_PERSISTENT) const;
+
+  /**
+   * @brief Stores the properties of this Properties object into a caller supplied buffer.
+   *        The values are written by store(), through a stream buffer over buf, so the output is byte-identical to
+   *        store() (preceded by the "[section]" line if a section is given) for every StoreOptions flag. The output
+   *        itself is not allocated, so it can be used from crash report and telemetry paths with a buffer sized once.
+   *        A terminating NUL is appended if there is room for it. The section may be given with or without brackets.
+   *
+   * @param[out] buf The buffer to write into.
+   * @param[in] bufSize The size of buf in bytes.
+   * @param[in] sep The separator character used between key and value.
+   * @param[in] section The section under which properties are stored (default: nullptr).
+   * @param[in] flags Flags indicating the storage behavior, @see StoreOptions.
+   * @return The number of bytes written, or 0 if the output does not fit (@see storedSize()); the buffer content is
+   *         unspecified in that case.
+   */
+  size_t storeBuffer(char* buf, size_t bufSize, char sep, const char* section = nullptr,
+                     int flags = Properties::STORE_ALL_PERSISTENT) const;
+
   /**
    * @brief Retrieves the current status of the section found flag.
    *
@@ -671,6 +976,25 @@ public:
 
   bool validateChecksum(MEtl::string& errMsg, const UInts* checksums);
 
+  /**
+   * @brief Validates checksum() against a list of valid incremental checksums.
+   *        This is an opt-in alternative to validateChecksum(): the two use different algorithms, so a list
+   *        computed for one never matches the other. validateChecksum() and STORE_CHECKSUM are not affected by it.
+   *
+   * @param[out] errMsg Appended with an error message if the checksum is not in the list.
+   * @param[in] checksums The valid checksums, as returned by checksum(); nullptr or an empty list accepts any checksum.
+   * @return true if the checksum is valid.
+   */
+  bool validateIncrementalChecksum(MEtl::string& errMsg, const UInts* checksums) const;
+
+  /**
+   * @brief Get the incremental checksum of the values of the CHECKSUM flagged properties: the XOR of their
+   *        Properties_EntryChecksum() contributions.
+   *        The checksum is updated as values are set, so reading it does not walk the values. It is not the checksum
+   *        validateChecksum() and STORE_CHECKSUM use.
+   */
+  uint32_t checksum() const { return _index.checksum(); }
+
   /**
    * @brief Set the default separator character for key-value pairs.
    *
@@ -736,6 +1060,28 @@ public:
    */
   bool validate(const MEtl::string& key, const MEtl::string& val, MEtl::string& whynot) const;
 
+  /// @brief A value rejected by validateAll().
+  struct ValidationFailure {
+    MEtl::string key;
+    MEtl::string value;
+    MEtl::string why;
+  };
+
+  /**
+   * @brief Validate the values of all registered properties in one pass, with the checks of a set.
+   *        Values are dispatched by Validator::validatorType(): canonical IPv4 addresses checked by the stock IP address
+   *        validator (@see Properties_SetStockIPAddressValidator()) and members of the discrete items (@see getValues())
+   *        checked by the stock discrete items validator (@see Properties_SetStockDiscreteItemsValidator()) are
+   *        accepted by batch kernels without calling the validator; all other values are checked by their validator.
+   *        Every value then goes through the container's validate() hook, as a set does. Error text is only produced
+   *        for values that fail.
+   *
+   * @param[out] failures Receives the rejected values, in index order.
+   * @param[in] stopOnFirstError Stop at the first rejected value.
+   * @return The number of rejected values.
+   */
+  size_t validateAll(std::vector<ValidationFailure>& failures, bool stopOnFirstError = false) const;
+
   int presetModified() { return _modifiedPresets; }
 
   /**
@@ -773,23 +1119,47 @@ public:
 #ifdef CHECK_LOADED_PROPERTY
     assert(_loaded != 0);
 #endif
-    const char* valString = _getProperty(var);
-    if (pexist) {
-      *pexist = (valString != nullptr);
-    }
-    // enable validation in order to return defaultVal not atot default
-    if (validator && valString) {
-      MEtl::string errorStr;
-      bool valid = validator->validate(var, valString, *this, errorStr);
-      if (!valid) {
-        return defaultVal;
-      }
-    }
-    if (valString) {
-      T nonConstDefaultVal(defaultVal);
-      return atot(nonConstDefaultVal, MEtl::string(valString));
-    }
-    return defaultVal;
+    return _getProperty(_index.find(var), defaultVal, pexist, validator, &var);
+  }
+
+  /**
+   * @brief Get the value of a property through a handle.
+   *
+   * Same as getProperty(const MEtl::string&, const T&, bool*, const Property::Validator*), without a key lookup.
+   *
+   * @tparam T The type to which the property value will be converted.
+   * @param[in] handle A handle obtained from handle() of this object.
+   * @param[in] defaultVal The default value to return if the property doesn't exist.
+   * @param[in] pexist A pointer to a bool indicating if the property exists (default: nullptr).
+   * @param[in] validator A pointer to a validator for optional value validation (default: nullptr).
+   * @return The property's value of type T, or the default value if the property is not found or validation fails.
+   */
+  template<typename T>
+  T getProperty(const PropertyHandle& handle, const T& defaultVal, bool* pexist = nullptr,
+                const Property::Validator* validator = nullptr) const {
+#ifdef CHECK_LOADED_PROPERTY
+    assert(_loaded != 0);
+#endif
+    assert(handle._container == this);
+    return _getProperty(handle._slot, defaultVal, pexist, validator);
+  }
+
+  const char* getProperty(const PropertyHandle& handle) const {
+    assert(handle._container == this);
+    const char* val = _index.value(handle._slot);
+    return val ? val : _presetValue(handle._slot, nullptr);
+  }
+
+  /**
+   * @brief Resolve a key to a handle for repeated O(1) access.
+   *
+   * The key does not need to exist yet: the handle starts resolving to a value once the key is loaded or set.
+   *
+   * @param[in] key The key of the property.
+   * @return A handle to the key in this Properties object.
+   */
+  PropertyHandle handle(const PropertyKey& key) {
+    return PropertyHandle(this, _index.insert(key.c_str(), key.size(), key.hash()));
   }
 
   MEtl::string getProperty(const MEtl::string& var, const char* defaultVal, bool* pexist = nullptr) const {
@@ -829,7 +1199,7 @@ public:
    */
   template<typename T>
   bool setProperty(const MEtl::string& var, const T& val, int flags = Property::FROM_USER) {
-    MEtl::string valString = ttoa(val);
+    MEtl::string valString = PropertyConvert<T>::toString(val);
     bool ok = _setProperty(var, valString, flags);
 #ifdef TEST_SET_PROPERTY
     bool exist;
@@ -843,6 +1213,23 @@ public:
     return ok;
   }
 
+  /**
+   * @brief Set the value of a property through a handle.
+   *
+   * Same as setProperty(const MEtl::string&, const T&, int), without a key lookup.
+   *
+   * @tparam T The type of the value to be set.
+   * @param[in] handle A handle obtained from handle() of this object.
+   * @param[in] val The value to be set.
+   * @param[in] flags The flags indicating the source of the property value (default: Property::FROM_USER).
+   * @return Returns true if the value was successfully set, otherwise false.
+   */
+  template<typename T>
+  bool setProperty(const PropertyHandle& handle, const T& val, int flags = Property::FROM_USER) {
+    assert(handle._container == this);
+    return _setProperty(handle._slot, PropertyConvert<T>::toString(val), flags);
+  }
+
   /**
    * @brief Set the value of a property using a 'ttoa' string.
    *
@@ -858,7 +1245,12 @@ public:
     return _setProperty(var, ttoaStr, Property::FROM_USER);
   }
 
-  const std::map<MEtl::string, MEtl::string>& properties() const { return _map; }
+  /**
+   * @brief Get a map-like view of all property values (key -> string value), in insertion order.
+   *
+   * @return A read-only view over the values held by this Properties object.
+   */
+  PropertiesIndex::ValueView properties() const { return _index.valueView(); }
   friend std::ostream& operator<<(std::ostream& out, const Properties& properties);
   void cut(std::vector<MEtl::string>& args);
   void add(const std::vector<MEtl::string>& args);
@@ -943,9 +1335,9 @@ public:
    * The map pairs the property's key with its value before it was modified. The original values can provide insight
    * into the changes made to the properties.
    *
-   * @return A map of modified properties and their original values.
+   * @return A map-like view of modified properties and their original values.
    */
-  const std::map<MEtl::string, MEtl::string>& modified() const { return _modified; }
+  PropertiesIndex::ModifiedView modified() const { return _index.modifiedView(); }
 
   /**
    * @brief Check if a property with the specified key has been modified after loading.
@@ -970,9 +1362,83 @@ public:
    */
   const Property* findProperty(const MEtl::string& key) const;
 
+  /**
+   * @brief Enable lock-free snapshots of this object for concurrent readers, and publish the first snapshot.
+   *
+   * Properties objects are not synchronized: getProperty() must not be called from other threads while this object is
+   * loaded or set. Reader threads use snapshot() instead; the writer publishes a new snapshot after every load (and
+   * on publishSnapshot()), readers keep seeing the snapshot they hold until they release it. Snapshots fall back to the
+   * shared presets (@see setPresets()) of the section that was current when they were published.
+   */
+  void enableSnapshots() { _snapshots.enable(_index, _presets, _presetSectionOf()); }
+
+  /// @brief Publish the current values to snapshot() readers. No-op unless enableSnapshots() was called.
+  void publishSnapshot() { _snapshots.publish(_index, _presets, _presetSectionOf()); }
+
+  /**
+   * @brief Get the most recently published snapshot. Wait-free and safe to call from any thread.
+   *
+   * @return A reader keeping the snapshot alive; it converts to false if no snapshot was published yet.
+   */
+  PropertiesSnapshotReader snapshot() const { return _snapshots.read(); }
+
   const std::list<const Property*>& properTies() const { return _properTies; }
   void sync();
 
+  /**
+   * @brief Re-sync and re-verify only the registered properties whose value text changed since the previous call,
+   *        then report all changed keys (registered or free) to onModifiedBatch() in one call.
+   *
+   * Unchanged properties are neither re-parsed nor re-verified: setting a key to its current text does not count as
+   * a change, and Property::sync() does not parse a value it was already synced from again. Loads call it once they
+   * are done. A single setProperty() is reported to onModified() right away and only joins the batch of the next call;
+   * to report a series of sets as one batch, call it after them or use ChangeBatch.
+   *
+   * @param[out] changedKeys If not nullptr, receives the changed keys.
+   * @return The number of changed keys.
+   */
+  size_t notifyChanged(std::vector<MEtl::string>* changedKeys = nullptr);
+
+  /**
+   * @class ChangeBatch
+   * @brief Scope guard calling notifyChanged() when it goes out of scope, so the changes made while it lives are
+   *        reported to onModifiedBatch() in one call.
+   */
+  class ChangeBatch {
+  public:
+    explicit ChangeBatch(Properties& properties)
+        : _properties(properties) {}
+    ~ChangeBatch() { _properties.notifyChanged(); }
+
+  private:
+    ChangeBatch(const ChangeBatch& other);
+    ChangeBatch& operator=(const ChangeBatch& other);
+
+    Properties& _properties;
+  };
+
+  /**
+   * @brief Get the arena of this Properties object, creating it on first use if arenas are enabled at that time.
+   *        The arena owns the validator copies of the registered properties and whatever else is created in it, and
+   *        releases them in one shot when this object is destroyed. Once created, the arena is used regardless of
+   *        later Properties_SetUseArenas() calls. @see Properties_SetUseArenas().
+   *
+   * @return The arena, or nullptr if arenas are disabled and none was created yet.
+   */
+  PropertiesArena* arena();
+
+  /**
+   * @brief Let registered properties store values set through ProperT::operator()(const T&) and
+   *        RWProperT::operator() directly, instead of letting sync() parse the formatted string back.
+   *        This saves the parse only: the value is still formatted on every write, since validators, validate(),
+   *        onRejected() and onModified() all take its text, and the text stays the stored value. Disabled by default,
+   *        since the binary value then keeps the precision it was set with, while setProperty() leaves it at the
+   *        precision of its text.
+   *
+   * @param[in] enable Whether to enable the typed set path.
+   */
+  void enableTypedSet(bool enable = true) { _typedSet = enable; }
+
   void deactivatePropsVerification() const;
 
   const std::vector<std::pair<MEtl::string, MEtl::string>>& rejectedFields() const { return _rejectedFields; }
@@ -985,11 +1451,69 @@ public:
   friend class PropertiesManager;
   void setPropertiesManager(PropertiesManager* propertiesManager);
   virtual bool verifyAllProps(const bool stopOnFirstError = false);
+
+  /// @brief A property rejected by verifyAllPropsParallel().
+  struct VerificationFailure {
+    const Properties* container;
+    MEtl::string key;
+    VerificationStatus_e status; /** < The result of Property::verifyVal(), never E_VERIFICATION_SUCCEEDED.*/
+  };
+
+  /**
+   * @brief Verify the properties requiring verification (@see Property::requiresVerification()) of several containers
+   *        in parallel.
+   *        Each container is verified by its own verifyAllProps(), so overrides keep their behavior; worker threads
+   *        take containers dynamically. With stopOnFirstError, no container ordered after a failed one is started,
+   *        and only the first failure is reported.
+   *        The report is deterministic: failures are in container order, then in properTies() order, as the serial
+   *        verification finds them (@see Property::getLastVerificationStatus()). A container rejected by its override
+   *        without a failed property is reported with an empty key. verifyAllProps() may be called concurrently for
+   *        different containers.
+   *
+   * @param[in] containers The containers to verify.
+   * @param[out] failures Receives the rejected properties.
+   * @param[in] stopOnFirstError Stop at the first rejected property.
+   * @param[in] threads The maximal number of threads to use, 0 for std::thread::hardware_concurrency().
+   * @return true if all properties were verified successfully.
+   */
+  static bool verifyAllPropsParallel(const std::vector<Properties*>& containers,
+                                     std::vector<VerificationFailure>& failures, bool stopOnFirstError = false,
+                                     unsigned int threads = 0);
   // override only for the cases of properties with non-unique section name
   virtual const MEtl::string& getPresetName() const { return _presetName.empty() ? getName() : _presetName; }
   void reloadPresets();
   void updatePresets();
 
+  /**
+   * @brief Read presets lazily from a table shared by all objects, instead of copying them into each object.
+   *        A key that has no value in this object is looked up in the section getPresetName() of the table: the
+   *        section is resolved on the first lookup and resolved again only if the name changes. Setting or loading
+   *        the key stores its value in this object as usual, which then overrides the preset. Lookups through
+   *        getProperty(), handles and snapshots (@see snapshot()) fall back to the presets, for registered properties
+   *        and free keys alike. properties(), store() and storeBinary() hold only the values of this object, so a
+   *        stored file does not turn presets into loaded values.
+   *
+   *        The table is independent of the presets that reloadPresets() and updatePresets() copy into the object:
+   *        those keep working as before, and setPresets() neither triggers nor replaces them. Attaching the table
+   *        publishes a new snapshot when snapshots are enabled.
+   *
+   *        Registered properties hold a binary value, so their presets are applied when the table is attached: a
+   *        registered property that has no value or only its default value is set to its preset (as a default,
+   *        Property::NOT_LOADED). Call setPresets() again after changing the name to apply the presets of the new
+   *        section to them.
+   *
+   * @param[in] presets The shared table, nullptr to stop using presets.
+   */
+  void setPresets(const std::shared_ptr<const PropertiesPresets>& presets);
+
+  /**
+   * @brief Get the preset of a key from the shared table (@see setPresets()), whether or not the key has a value.
+   *
+   * @param[in] key The key.
+   * @return The preset value, or nullptr if there is no table or it has no preset for the key.
+   */
+  const char* presetValue(const MEtl::string& key) const;
+
 protected:
   unsigned int _loaded; /** < Flag indicating whether properties have been loaded. */
   PropertiesManager* _propertiesManager;
@@ -998,18 +1522,84 @@ private:
   bool validate(const MEtl::string& str, char sep) const;
   bool validate(std::istream& in, char sep) const;
   virtual int store3(char* buf, int sizeOfBuf, char sep) const;
+  struct StoreSink;
+  void _storeTo(StoreSink& sink, char sep, const char* section, int flags) const;
 
   int _loadPresets;
   int _modifiedPresets;
   std::vector<std::pair<MEtl::string, MEtl::string>> _rejectedFields;
 
   friend class Property;
+  friend class PropertiesBinary;
+  friend class PropertiesLoadPipeline;
   Properties(const Properties& other);
   Properties& operator=(const Properties& other);
   const char* _getProperty(const MEtl::string& var) const;
 
+  /// @brief The section getPresetName() of the shared table, resolved once per name; nullptr without presets.
+  const PropertiesPresets::Section* _presetSectionOf() const;
+
+  /// @brief The preset of a key that has no value in this object, read from the shared table (@see setPresets()).
+  const char* _presetValue(PropertiesIndex::Slot slot, const MEtl::string* var) const {
+    if (!_presets) {
+      return nullptr;
+    }
+    if (slot != PropertiesIndex::NPOS) {
+      return presetValue(*_index.at(slot).key);
+    }
+    return var ? presetValue(*var) : nullptr;
+  }
+
+  template<typename T>
+  T _getProperty(PropertiesIndex::Slot slot, const T& defaultVal, bool* pexist, const Property::Validator* validator,
+                 const MEtl::string* var = nullptr) const {
+    bool exists = (slot != PropertiesIndex::NPOS) && (_index.at(slot).flags & PropertiesIndex::HAS_VALUE);
+    const char* preset = exists ? nullptr : _presetValue(slot, var);
+    if (pexist) {
+      *pexist = exists || preset;
+    }
+    if (!exists && !preset) {
+      return defaultVal;
+    }
+    const char* text = preset ? preset : _index.value(slot);
+    // enable validation in order to return defaultVal not atot default
+    if (validator) {
+      MEtl::string errorStr;
+      bool valid = validator->validate(slot != PropertiesIndex::NPOS ? *_index.at(slot).key : *var, text, *this,
+                                       errorStr);
+      if (!valid) {
+        return defaultVal;
+      }
+    }
+    // a registered property of the same type already holds the parsed value
+    const Property* property = _index.property(slot);
+    if (!preset && property && _index.isSynced(slot)) {
+      const void* typed = property->typedValue(PropertyTypeTag<T>::id());
+      if (typed) {
+        return *static_cast<const T*>(typed);
+      }
+    }
+    T nonConstDefaultVal(defaultVal);
+    return PropertyConvert<T>::fromString(nonConstDefaultVal, MEtl::string(text));
+  }
+
 protected:
   bool _setProperty(const MEtl::string& var, const MEtl::string& val, unsigned int loaded);
+  bool _setProperty(PropertiesIndex::Slot slot, const MEtl::string& val, unsigned int loaded);
+
+  /**
+   * @brief The two halves of _setProperty(PropertiesIndex::Slot, ...). _acceptValue() validates a new value of a slot
+   *        and reports a rejection to onRejected(); it returns the current value in from (hadValue is false if there
+   *        is none). _storeValue() stores the accepted value and reports a change to onModified(); if synced, the
+   *        property's binary value was already set to it (@see Property::setTyped()), otherwise it is synced.
+   */
+  bool _acceptValue(PropertiesIndex::Slot slot, const MEtl::string& val, MEtl::string& from, bool& hadValue);
+  void _storeValue(PropertiesIndex::Slot slot, const MEtl::string& val, unsigned int loaded, const MEtl::string& from,
+                   bool hadValue, bool synced);
+  bool _loadRecord(std::string_view key, const MEtl::string& value, unsigned int source,
+                   std::vector<std::pair<MEtl::string, MEtl::string>>& unknownFields);
+  static bool loadRecords(IniTokenizer& tokenizer, const std::vector<Properties*>& containers, unsigned int source);
+  void _loadFinished(unsigned int source, std::vector<std::pair<MEtl::string, MEtl::string>>& unknownFields);
 
 private:
   void falsifyBoolshits(unsigned int source = Property::FROM_INF);
@@ -1024,14 +1614,23 @@ private:
   virtual void onModified(const Property* property, const MEtl::string& key, const MEtl::string& from,
                           const MEtl::string& to) {}
 
+  /**
+   * @brief Called once per notifyChanged() with all keys whose value text changed since the previous call.
+   *
+   * @param[in] keys The changed keys, in the order they first changed.
+   */
+  virtual void onModifiedBatch(const std::vector<MEtl::string>& keys) {}
+
 protected:
   virtual void onLoaded() {}
 
 private:
   virtual void exec(const char* command);
   void postLoaded();
-  std::map<MEtl::string, MEtl::string> _map;
-  std::map<MEtl::string, int> _unformatted;
+  PropertiesIndex _index; /** < Values, registered properties, loaded bits and modifications of all keys.*/
+  PropertiesSnapshotSlot _snapshots; /** < Published snapshots of _index for concurrent readers.*/
+  std::unique_ptr<PropertiesArena> _arena; /** < Owns validator copies, destroyed after the derived properties.*/
+  bool _typedSet = false; /** < @see enableTypedSet().*/
   void add(std::vector<MEtl::string>& args, bool cut);
   InputStringValidityCheckPolicy _checkInputStringValidity;
 
@@ -1044,12 +1643,9 @@ protected:
 private:
   bool _sectionFound;// information about most recent load() call
 
-  std::map<MEtl::string, const Property*> _metaData;
   std::list<const Property*> _properTies;
   MEtl::string _name;     /** < The section name used for loading and storing properties.*/
   MEtl::string _fileName; /** < The associated file name for the properties.*/
-  std::map<MEtl::string, MEtl::string>
-      _modified; /** < A map storing modified property values before they were modified.*/
   unsigned int _defaultPropertyFlags;
   std::list<MEtl::string> _pendingExec;
 
@@ -1060,6 +1656,8 @@ protected:
   Properties* _me;
   char _defaultSeparator; /** < The default separator used for key-value pairs in the properties.*/
   MEtl::string _presetName;
+  std::shared_ptr<const PropertiesPresets> _presets;                                /** < @see setPresets().*/
+  mutable std::atomic<const PropertiesPresets::Section*> _presetSection{ nullptr }; /** < Last resolved section.*/
 };
 
 class boolshit {
@@ -1210,7 +1808,14 @@ public:
    * @return True if the property value was successfully set, false otherwise.
    */
   virtual bool operator()(const T& val) {
-    return this->_container->setProperty(this->name, val);
+    PropertiesIndex::Slot slot = typedSetSlot();
+    if (slot == PropertiesIndex::NPOS) {
+      return this->_container->setProperty(this->name, val);
+    }
+    return setTyped(slot, PropertyConvert<T>::toString(val), [&]() {
+      _val = val;
+      VerifierT::syncVerifiers(_container->getName().c_str());
+    });
   }
 
   /**
@@ -1224,14 +1829,36 @@ public:
    * @return True if the value is valid for the property, false otherwise.
    */
   bool valid(const T& val, MEtl::string& whyNot) const {
-    return validate(name, ttoa(val), *_container, whyNot);
+    return validate(name, PropertyConvert<T>::toString(val), *_container, whyNot);
   }
 
   virtual void sync(const MEtl::string& val) const {
-    atot(((T&)_val), val);
+    // _val may already be parsed from this text, e.g. a reload that did not change this property; the verifiers are
+    // synced either way
+    if (!isSynced(val)) {
+      PropertyConvert<T>::fromString((T&)_val, val);
+      markSynced(val);
+    }
     VerifierT::syncVerifiers(_container->getName().c_str());
   }
 
+  virtual const void* typedValue(const void* typeTag) const override {
+    if (typeTag != PropertyTypeTag<T>::id()) {
+      return nullptr;
+    }
+    VerifierT::verifyAuto(_val);
+    return &_val;
+  }
+
+  virtual bool assignTypedValue(const void* typeTag, const void* val) const override {
+    if (typeTag != PropertyTypeTag<T>::id()) {
+      return false;
+    }
+    (T&)_val = *static_cast<const T*>(val);
+    VerifierT::syncVerifiers(_container->getName().c_str());
+    return true;
+  }
+
   /**
    * @brief Get the name of the container to which the property belongs.
    *
@@ -1251,7 +1878,7 @@ public:
    * @return A string representation of the property value.
    */
   virtual MEtl::string ttoaStr() const {
-    return ttoa(((T&)_val));
+    return PropertyConvert<T>::toString(_val);
   }
 
   /**
@@ -1417,7 +2044,7 @@ public:
    * @return True if the property value was successfully set, false otherwise.
    */
   bool operator()(const T& val) {
-    return this->_container->setProperty(this->name, val);
+    return ProperT<T, VerifierT>::operator()(val);
   }
 
   /**
@@ -1458,11 +2085,11 @@ public:
     if (val <= 0) {
       boolVal = false;
     }
-    return this->_container->setProperty(this->name, boolVal);
+    return ProperT<bool>::operator()(boolVal);
   }
 
   bool operator()(const bool& val) {
-    return this->_container->setProperty(this->name, val);
+    return ProperT<bool>::operator()(val);
   }
   const bool& operator()(bool* hasValue = nullptr) const {
     return ProperT<bool>::operator()(hasValue);
@@ -1474,14 +2101,92 @@ bool Property::defaultProperty(const MEtl::string& var, const T& val) {
   return _container->setProperty(var, val, Property::NOT_LOADED);
 }
 
+inline void Property::rehomeValidator(Properties* container) {
+  if (_ownsValidator || !_validator || !_copyValidator || container == _container) {
+    return;
+  }
+  _validator = _copyValidator(container, *_validator);
+  _ownsValidator = !arenaOf(container);
+}
+
 inline void Property::changeContainer(Properties* container, const MEtl::string& var, const MEtl::string& val) {
+  rehomeValidator(container);
   _container = container;
+  _slot = PropertiesIndex::NPOS;
   _container->add(this);
   _container->setProperty(var, val, Property::NOT_LOADED);
 }
 
 inline void Property::changeContainer(Properties* container) {
+  rehomeValidator(container);
   _container = container;
+  _slot = PropertiesIndex::NPOS;
+}
+
+inline Property::~Property() {
+  PropertiesIndex::Slot slot = _container ? this->slot() : PropertiesIndex::NPOS;
+  if (slot != PropertiesIndex::NPOS) {
+    _container->_index.removeProperty(slot);
+  }
+  if (_ownsValidator && _validator) {
+    delete _validator;
+    _validator = nullptr;
+  }
+}
+
+inline PropertiesArena* Property::arenaOf(Properties* container) {
+  return container ? container->arena() : nullptr;
+}
+
+inline PropertiesArena* Properties::arena() {
+  if (!_arena && Properties_GetUseArenas()) {
+    _arena.reset(new PropertiesArena());
+  }
+  return _arena.get();
+}
+
+inline PropertiesIndex::Slot Property::typedSetSlot() const {
+  if (!_container || !_container->_typedSet) {
+    return PropertiesIndex::NPOS;
+  }
+  return slot();
+}
+
+template<typename ASSIGN>
+bool Property::setTyped(PropertiesIndex::Slot slot, const MEtl::string& val, ASSIGN assign) const {
+  MEtl::string from;
+  bool hadValue;
+  if (!_container->_acceptValue(slot, val, from, hadValue)) {
+    return false;
+  }
+  assign();
+  _container->_storeValue(slot, val, Property::FROM_USER, from, hadValue, true);
+  return true;
+}
+
+inline PropertiesIndex::Slot Property::slot() const {
+  if (_slot == PropertiesIndex::NPOS) {
+    PropertiesIndex::Slot slot = _container->_index.find(name);
+    if (_container->_index.property(slot) != this) {
+      return PropertiesIndex::NPOS;
+    }
+    _slot = slot;
+  }
+  return _slot;
+}
+
+inline bool Property::isSynced(const MEtl::string& val) const {
+  PropertiesIndex::Slot slot = this->slot();
+  const PropertiesIndex& index = _container->_index;
+  return slot != PropertiesIndex::NPOS && index.isSynced(slot) && index.at(slot).value == val;
+}
+
+inline void Property::markSynced(const MEtl::string& val) const {
+  PropertiesIndex::Slot slot = this->slot();
+  PropertiesIndex& index = _container->_index;
+  if (slot != PropertiesIndex::NPOS && index.at(slot).value == val) {
+    index.markSynced(slot);
+  }
 }
 
 // This class contains the items that are to be relevant for all Properties classes.
@@ -1494,6 +2199,28 @@ public:
   RWProperT<MEtl::string> objectsWithSameSectionNamePolicy;
 };
 
+/**
+ * @brief Register the dynamic type of the stock IP address validator.
+ *
+ * Properties::validateAll() accepts canonical dotted-quad IPv4 values without calling a validator only if the
+ * validator is exactly of this type; a validator merely reporting IP_ADDRESS_VALIDATOR (e.g. a subclass that also
+ * restricts the range) is always called. Until a type is registered, every IP address validator is called.
+ *
+ * @param type typeid() of the stock IP address validator class.
+ */
+extern void Properties_SetStockIPAddressValidator(const std::type_info& type);
+
+/**
+ * @brief Register the dynamic type of the stock discrete items validator.
+ *
+ * Properties::validateAll() accepts members of getValues() without calling a validator only if the validator is
+ * exactly of this type; a subclass overriding validate() is always called. Until a type is registered, every discrete
+ * items validator is called.
+ *
+ * @param type typeid() of the stock discrete items validator class.
+ */
+extern void Properties_SetStockDiscreteItemsValidator(const std::type_info& type);
+
 /**
  * @brief Removes leading '/' from the prefix of a file name for offline and embedded Linux systems platform.
  *
@@ -1612,6 +2339,19 @@ extern bool Properties_GetListOfSections(std::list<MEtl::string>& sections, cons
  */
 extern bool Properties_isSectionExist(const MEtl::string& section, const MEtl::string& iniStr);
 
+/**
+ * @brief Checks for the existence of a section within an indexed INI-formatted buffer.
+ *
+ * Same as Properties_isSectionExist(const MEtl::string&, const MEtl::string&), with a single index lookup instead of
+ * a scan of the buffer.
+ *
+ * @param section The section name to be checked for existence.
+ * @param index The section index of the INI-formatted buffer.
+ *
+ * @return True if the specified section exists within the indexed buffer, false otherwise.
+ */
+extern bool Properties_isSectionExist(const MEtl::string& section, const PropertiesSectionIndex& index);
+
 /**
  * @brief Retrieves a map of sections from an INI-formatted string.
  *
@@ -1633,6 +2373,20 @@ extern bool Properties_isSectionExist(const MEtl::string& section, const MEtl::s
  */
 extern bool Properties_GetMapOfSections(std::map<MEtl::string, MEtl::string>& sections, const MEtl::string& iniStr);
 
+/**
+ * @brief Retrieves a map of sections from an indexed INI-formatted buffer.
+ *
+ * Same as Properties_GetMapOfSections(std::map<MEtl::string, MEtl::string>&, const MEtl::string&), using the offsets
+ * already held by the index. Of a repeated section, the last occurrence is kept.
+ *
+ * @param[out] sections Reference to a map where sections and their contents will be stored.
+ * @param[in] index The section index of the INI-formatted buffer.
+ *
+ * @return True if the map was populated, false if the indexed buffer has no sections.
+ */
+extern bool Properties_GetMapOfSections(std::map<MEtl::string, MEtl::string>& sections,
+                                        const PropertiesSectionIndex& index);
+
 /**
  * @brief Retrieves data belonging to a specified section from an INI-formatted string.
  *
@@ -1653,6 +2407,20 @@ extern bool Properties_GetMapOfSections(std::map<MEtl::string, MEtl::string>& se
  */
 extern bool Properties_GetSectionData(const char* section, const MEtl::string& iniStr, MEtl::string& data);
 
+/**
+ * @brief Retrieves data belonging to a specified section from an indexed INI-formatted buffer.
+ *
+ * Same as Properties_GetSectionData(const char*, const MEtl::string&, MEtl::string&), with a single index lookup
+ * instead of a scan of the buffer.
+ *
+ * @param[in] section The section name whose data needs to be retrieved.
+ * @param[in] index The section index of the INI-formatted buffer.
+ * @param[out] data Reference to a string where the extracted section data will be stored.
+ *
+ * @return True if the section was found and its data stored in `data`, false if the section is not found.
+ */
+extern bool Properties_GetSectionData(const char* section, const PropertiesSectionIndex& index, MEtl::string& data);
+
 /**
  * @brief Converts command line arguments to a calib format string.
  *
@@ -0,0 +1,67 @@
+/**
+ * @file PropertiesAccess.cpp
+ * @brief Getting and setting the string values of a Properties object through its index.
+ */
+
+#include "Properties.h"
+
+const char* Properties::_getProperty(const MEtl::string& var) const {
+  PropertiesIndex::Slot slot = _index.find(var);
+  const char* val = _index.value(slot);
+  return val ? val : _presetValue(slot, &var);
+}
+
+bool Properties::_setProperty(const MEtl::string& var, const MEtl::string& val, unsigned int loaded) {
+  return _setProperty(_index.insert(var), val, loaded);
+}
+
+bool Properties::_setProperty(PropertiesIndex::Slot slot, const MEtl::string& val, unsigned int loaded) {
+  MEtl::string from;
+  bool hadValue;
+  if (!_acceptValue(slot, val, from, hadValue)) {
+    return false;
+  }
+  _storeValue(slot, val, loaded, from, hadValue, false);
+  return true;
+}
+
+bool Properties::_acceptValue(PropertiesIndex::Slot slot, const MEtl::string& val, MEtl::string& from,
+                              bool& hadValue) {
+  const char* current = _index.value(slot);
+  hadValue = current != nullptr;
+  from = hadValue ? current : "";
+  const Property* property = _index.property(slot);
+  if (!property) {
+    return true;
+  }
+  const MEtl::string& key = *_index.at(slot).key;
+  MEtl::string whyNot;
+  if (!property->validate(key, val, *this, whyNot) || !validate(property, key, val, whyNot)) {
+    onRejected(property, key, from, val, whyNot);
+    setRejected(key, val, *this, whyNot);
+    return false;
+  }
+  return true;
+}
+
+void Properties::_storeValue(PropertiesIndex::Slot slot, const MEtl::string& val, unsigned int loaded,
+                             const MEtl::string& from, bool hadValue, bool synced) {
+  // only values set by the user count as modifications, loaded and default values do not
+  bool markModified = (loaded & Property::FROM_USER) != 0;
+  bool changed = !hadValue || from != val;
+  _index.setValue(slot, val, loaded, markModified);
+  const Property* property = _index.property(slot);
+  if (!property) {
+    return;
+  }
+  property->loaded |= loaded;
+  property->modified = property->modified || (markModified && changed);
+  if (synced) {
+    _index.markSynced(slot);
+  } else {
+    property->sync(_index.at(slot).value);
+  }
+  if (changed && loaded != Property::NOT_LOADED) {
+    onModified(property, *_index.at(slot).key, from, val);
+  }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file PropertiesArena.cpp
+ */
+
+#include "PropertiesArena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+std::atomic<size_t> PropertiesArena::_heapAllocations(0);
+
+namespace {
+std::atomic<bool> g_useArenas(false);
+}
+
+void Properties_SetUseArenas(bool enable) {
+  g_useArenas.store(enable, std::memory_order_relaxed);
+}
+
+bool Properties_GetUseArenas() {
+  return g_useArenas.load(std::memory_order_relaxed);
+}
+
+PropertiesArena::PropertiesArena(size_t chunkSize)
+    : _chunkSize(chunkSize)
+    , _chunk(nullptr)
+    , _next(nullptr)
+    , _end(nullptr)
+    , _finalizers(nullptr)
+    , _objects(0)
+    , _chunks(0)
+    , _bytes(0) {}
+
+PropertiesArena::~PropertiesArena() {
+  for (Finalizer* finalizer = _finalizers; finalizer; finalizer = finalizer->next) {
+    finalizer->destructor(finalizer->object);
+  }
+  while (_chunk) {
+    Chunk* previous = _chunk->next;
+    free(_chunk);
+    _chunk = previous;
+  }
+}
+
+void* PropertiesArena::allocate(size_t size, size_t align) {
+  uintptr_t aligned = (reinterpret_cast<uintptr_t>(_next) + align - 1) & ~static_cast<uintptr_t>(align - 1);
+  if (!_chunk || aligned + size > reinterpret_cast<uintptr_t>(_end)) {
+    // oversized requests get a chunk of their own
+    size_t chunkSize = sizeof(Chunk) + align + size;
+    if (chunkSize < _chunkSize) {
+      chunkSize = _chunkSize;
+    }
+    Chunk* chunk = static_cast<Chunk*>(malloc(chunkSize));
+    if (!chunk) {
+      throw std::bad_alloc();
+    }
+    countHeapAllocation();
+    ++_chunks;
+    chunk->next = _chunk;
+    chunk->size = chunkSize;
+    _chunk = chunk;
+    _next = reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+    _end = reinterpret_cast<char*>(chunk) + chunkSize;
+    aligned = (reinterpret_cast<uintptr_t>(_next) + align - 1) & ~static_cast<uintptr_t>(align - 1);
+  }
+  _next = reinterpret_cast<char*>(aligned + size);
+  _bytes += size;
+  return reinterpret_cast<void*>(aligned);
+}
+
+void PropertiesArena::addDestructor(void* object, Destructor destructor) {
+  Finalizer* finalizer = static_cast<Finalizer*>(allocate(sizeof(Finalizer), alignof(Finalizer)));
+  finalizer->next = _finalizers;
+  finalizer->object = object;
+  finalizer->destructor = destructor;
+  _finalizers = finalizer;
+}
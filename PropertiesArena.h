@@ -0,0 +1,114 @@
+/**
+ * @file PropertiesArena.h
+ */
+
+#ifndef __PROPERTIES_ARENA__H__
+#define __PROPERTIES_ARENA__H__
+
+#include <stddef.h>
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class PropertiesArena
+ * @brief A monotonic arena owning objects allocated on behalf of one Properties container.
+ *
+ * Objects are bump-allocated from chunks; nothing is freed individually. Destroying the arena runs the destructors of
+ * the objects it created (in reverse order of creation) and frees all chunks at once. The destructor list is kept in
+ * the arena itself, so creating an object costs no heap allocation unless a new chunk is needed.
+ *
+ * The arena is not thread safe; it follows the threading rules of the container owning it.
+ */
+class PropertiesArena {
+public:
+  explicit PropertiesArena(size_t chunkSize = 4096);
+  ~PropertiesArena();
+
+  /**
+   * @brief Allocate raw memory that lives as long as the arena.
+   *
+   * @param[in] size The number of bytes.
+   * @param[in] align The alignment, a power of two.
+   * @return The memory.
+   */
+  void* allocate(size_t size, size_t align);
+
+  /**
+   * @brief Construct an object in the arena; its destructor runs when the arena is destroyed.
+   *
+   * @tparam T The type of the object.
+   * @param[in] args The constructor arguments.
+   * @return The object.
+   */
+  template<typename T, typename... ARGS>
+  T* create(ARGS&&... args) {
+    T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<ARGS>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+      addDestructor(object, &PropertiesArena::destroy<T>);
+    }
+    ++_objects;
+    return object;
+  }
+
+  size_t objects() const { return _objects; } /** < Objects created so far.*/
+  size_t chunks() const { return _chunks; }   /** < Heap allocations made so far.*/
+  size_t bytes() const { return _bytes; }     /** < Bytes allocated so far.*/
+
+  /**
+   * @brief Instrumentation: heap allocations made for Properties objects' validators and arenas, process wide.
+   *
+   * Compare the counter with and without arenas (Properties_SetUseArenas()) to measure the reduction.
+   */
+  static size_t heapAllocations() { return _heapAllocations.load(std::memory_order_relaxed); }
+  static void countHeapAllocation() { _heapAllocations.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+  PropertiesArena(const PropertiesArena& other);
+  PropertiesArena& operator=(const PropertiesArena& other);
+
+  typedef void (*Destructor)(void*);
+  struct Chunk {
+    Chunk* next;
+    size_t size;
+  };
+  struct Finalizer {
+    Finalizer* next;
+    void* object;
+    Destructor destructor;
+  };
+
+  template<typename T>
+  static void destroy(void* object) {
+    static_cast<T*>(object)->~T();
+  }
+
+  void addDestructor(void* object, Destructor destructor);
+
+  size_t _chunkSize;
+  Chunk* _chunk;          /** < The current chunk, chunks are linked to the previous ones.*/
+  char* _next;            /** < The next free byte in the current chunk.*/
+  char* _end;             /** < The end of the current chunk.*/
+  Finalizer* _finalizers; /** < The objects to destroy, most recent first.*/
+  size_t _objects;
+  size_t _chunks;
+  size_t _bytes;
+  static std::atomic<size_t> _heapAllocations;
+};
+
+/**
+ * @brief Enable or disable per-container arenas for Properties objects that have not created their arena yet.
+ *
+ * With arenas enabled, each Properties object places the validator copies of its properties in its own monotonic
+ * arena (@see Properties::arena()) instead of allocating each on the heap. A Properties object creates its arena
+ * when it copies its first validator while arenas are enabled; an object that already has an arena keeps using it
+ * after arenas are disabled. Disabled by default.
+ *
+ * @param enable Whether to use arenas.
+ */
+extern void Properties_SetUseArenas(bool enable);
+extern bool Properties_GetUseArenas();
+
+#endif//__PROPERTIES_ARENA__H__
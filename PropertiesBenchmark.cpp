@@ -0,0 +1,65 @@
+/**
+ * @file PropertiesBenchmark.cpp
+ * @brief Micro-benchmark of getProperty<T>(): the lookup and parse it replaces against the index and the typed path.
+ *
+ * Prints the calls per second of:
+ *  - a std::map<MEtl::string, MEtl::string> lookup followed by atot(), as getProperty<T>() did before the index;
+ *  - getProperty<T>() of a free key: an index lookup followed by a parse of the string value;
+ *  - getProperty<T>() of a registered ProperT: an index lookup returning the cached binary value.
+ *
+ * Usage: PropertiesBenchmark [iterations] (default: 1000000)
+ */
+
+#include "Properties.h"
+#include "PropertiesBenchmark.h"
+
+#include <stdio.h>
+
+#include <map>
+
+using namespace PropertiesBenchmark;
+
+namespace {
+const size_t KEYS = 256;
+
+struct TypedProperties : public Properties {
+  TypedProperties()
+      : Properties("bench")
+      , gain(this, 42, "gain", "a registered int", Property::DEFAULT_FLAGS) {}
+  ProperT<int> gain;
+};
+
+void benchmarkGetProperty(size_t iterations) {
+  // the same number of keys in the map and in the object, so both lookups search tables of the same size
+  TypedProperties properties;
+  std::map<MEtl::string, MEtl::string> map;
+  for (size_t i = 0; i < KEYS; ++i) {
+    char name[32];
+    snprintf(name, sizeof(name), "key%zu", i);
+    properties.setProperty(MEtl::string(name), 42);
+    map[MEtl::string(name)] = "42";
+  }
+  map[MEtl::string("gain")] = "42";
+  const MEtl::string registered("gain");
+  const MEtl::string free("key7");
+
+  double mapParse = opsPerSecond(iterations, [&](size_t) {
+    int val = 0;
+    std::map<MEtl::string, MEtl::string>::const_iterator it = map.find(free);
+    if (it != map.end()) {
+      atot(val, it->second);
+    }
+    g_sink += val;
+  });
+  double indexParse = opsPerSecond(iterations, [&](size_t) { g_sink += properties.getProperty<int>(free, 0); });
+  double typed = opsPerSecond(iterations, [&](size_t) { g_sink += properties.getProperty<int>(registered, 0); });
+  report("getProperty<int>", "std::map + atot() (former path)", mapParse);
+  report("", "free key (index + parse)", indexParse, mapParse);
+  report("", "registered ProperT (index, typed)", typed, mapParse);
+}
+}// namespace
+
+int main(int argc, char* argv[]) {
+  benchmarkGetProperty(iterations(argc, argv));
+  return 0;
+}
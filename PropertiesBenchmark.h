@@ -0,0 +1,45 @@
+/**
+ * @file PropertiesBenchmark.h
+ * @brief Timing helpers shared by the Properties micro-benchmarks.
+ */
+
+#ifndef __PROPERTIES_BENCHMARK__H__
+#define __PROPERTIES_BENCHMARK__H__
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+
+namespace PropertiesBenchmark {
+/// @brief Measured results are added here, so the work is not optimized away.
+inline volatile long long g_sink = 0;
+
+/// @brief Call fn(i) for i in [0, iterations) and return the calls per second.
+template<typename FN>
+double opsPerSecond(size_t iterations, FN fn) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return seconds > 0 ? iterations / seconds : 0;
+}
+
+/// @brief Print one measured path; with a baseline, also its speedup over the baseline.
+inline void report(const char* name, const char* path, double ops, double baselineOps = 0) {
+  if (baselineOps > 0) {
+    printf("%-24s %-32s %14.0f ops/s (x%.2f)\n", name, path, ops, ops / baselineOps);
+  } else {
+    printf("%-24s %-32s %14.0f ops/s\n", name, path, ops);
+  }
+}
+
+/// @brief The iteration count of a benchmark: its first argument, 1000000 by default.
+inline size_t iterations(int argc, char* argv[]) {
+  return argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+}
+}// namespace PropertiesBenchmark
+
+#endif//__PROPERTIES_BENCHMARK__H__
@@ -0,0 +1,341 @@
+/**
+ * @file PropertiesBinary.cpp
+ */
+
+#include "PropertiesBinary.h"
+#include "Properties.h"
+#include "PropertiesChecksum.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+const char MAGIC[8] = { 'P', 'R', 'O', 'P', 'B', 'I', 'N', '\0' };
+
+template<typename T>
+bool probeSigned(const Property* property, uint64_t& bits) {
+  const void* typed = property->typedValue(PropertyTypeTag<T>::id());
+  if (!typed) {
+    return false;
+  }
+  int64_t val = static_cast<int64_t>(*static_cast<const T*>(typed));
+  memcpy(&bits, &val, sizeof(bits));
+  return true;
+}
+
+template<typename T>
+bool probeUnsigned(const Property* property, uint64_t& bits) {
+  const void* typed = property->typedValue(PropertyTypeTag<T>::id());
+  if (!typed) {
+    return false;
+  }
+  bits = static_cast<uint64_t>(*static_cast<const T*>(typed));
+  return true;
+}
+
+template<typename T>
+bool probeFloating(const Property* property, uint64_t& bits) {
+  const void* typed = property->typedValue(PropertyTypeTag<T>::id());
+  if (!typed) {
+    return false;
+  }
+  double val = static_cast<double>(*static_cast<const T*>(typed));
+  memcpy(&bits, &val, sizeof(bits));
+  return true;
+}
+
+PropertiesBinary::ValueKind probeKind(const Property* property, uint64_t& bits) {
+  bits = 0;
+  if (!property) {
+    return PropertiesBinary::KIND_STRING;
+  }
+  if (probeUnsigned<bool>(property, bits)) {
+    return PropertiesBinary::KIND_BOOL;
+  }
+  if (probeSigned<int>(property, bits) || probeSigned<long>(property, bits) || probeSigned<long long>(property, bits) ||
+      probeSigned<short>(property, bits) || probeSigned<signed char>(property, bits) ||
+      probeSigned<char>(property, bits)) {
+    return PropertiesBinary::KIND_INT;
+  }
+  if (probeUnsigned<unsigned int>(property, bits) || probeUnsigned<unsigned long>(property, bits) ||
+      probeUnsigned<unsigned long long>(property, bits) || probeUnsigned<unsigned short>(property, bits) ||
+      probeUnsigned<unsigned char>(property, bits)) {
+    return PropertiesBinary::KIND_UINT;
+  }
+  if (probeFloating<double>(property, bits) || probeFloating<float>(property, bits)) {
+    return PropertiesBinary::KIND_DOUBLE;
+  }
+  return PropertiesBinary::KIND_STRING;
+}
+
+template<typename T>
+bool assignAs(const Property* property, T val) {
+  return property->assignTypedValue(PropertyTypeTag<T>::id(), &val);
+}
+
+/// @brief Assign a stored binary value to a property of any type of the value's kind, as probeKind() found it.
+bool assignBinary(const Property* property, const PropertiesBinary::Value& value) {
+  switch (value.kind) {
+    case PropertiesBinary::KIND_BOOL:
+      return assignAs<bool>(property, value.bits != 0);
+    case PropertiesBinary::KIND_INT: {
+      int64_t val;
+      memcpy(&val, &value.bits, sizeof(val));
+      return assignAs<int>(property, static_cast<int>(val)) || assignAs<long>(property, static_cast<long>(val)) ||
+             assignAs<long long>(property, static_cast<long long>(val)) ||
+             assignAs<short>(property, static_cast<short>(val)) ||
+             assignAs<signed char>(property, static_cast<signed char>(val)) ||
+             assignAs<char>(property, static_cast<char>(val));
+    }
+    case PropertiesBinary::KIND_UINT:
+      return assignAs<unsigned int>(property, static_cast<unsigned int>(value.bits)) ||
+             assignAs<unsigned long>(property, static_cast<unsigned long>(value.bits)) ||
+             assignAs<unsigned long long>(property, static_cast<unsigned long long>(value.bits)) ||
+             assignAs<unsigned short>(property, static_cast<unsigned short>(value.bits)) ||
+             assignAs<unsigned char>(property, static_cast<unsigned char>(value.bits));
+    case PropertiesBinary::KIND_DOUBLE: {
+      double val;
+      memcpy(&val, &value.bits, sizeof(val));
+      return assignAs<double>(property, val) || assignAs<float>(property, static_cast<float>(val));
+    }
+    default:
+      return false;
+  }
+}
+
+class StringTable {
+public:
+  uint32_t add(std::string_view str) {
+    uint32_t offset = static_cast<uint32_t>(_data.size());
+    _data.append(str.data(), str.size());
+    _data.push_back('\0');
+    return offset;
+  }
+  const MEtl::string& data() const { return _data; }
+
+private:
+  MEtl::string _data;
+};
+
+size_t align8(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+}// namespace
+
+bool PropertiesBinary::store(const char* file, const std::vector<const Properties*>& containers,
+                             MEtl::string& errMsg) {
+  std::vector<SectionEntry> sectionTable;
+  std::vector<ValueEntry> valueTable;
+  StringTable strings;
+
+  for (size_t c = 0; c < containers.size(); ++c) {
+    const Properties& properties = *containers[c];
+    const PropertiesIndex& index = properties._index;
+    SectionEntry section;
+    memset(&section, 0, sizeof(section));
+    section.name = strings.add(properties.getName());
+    section.nameSize = static_cast<uint32_t>(properties.getName().size());
+    section.firstValue = static_cast<uint32_t>(valueTable.size());
+    for (PropertiesIndex::Slot slot = 0; slot < index.slots(); ++slot) {
+      const PropertiesIndex::Entry& entry = index.at(slot);
+      if (!(entry.flags & PropertiesIndex::HAS_VALUE)) {
+        continue;
+      }
+      const Property* property = index.property(slot);
+      ValueEntry value;
+      memset(&value, 0, sizeof(value));
+      value.key = strings.add(*entry.key);
+      value.keySize = static_cast<uint32_t>(entry.key->size());
+      value.value = strings.add(entry.value);
+      value.valueSize = static_cast<uint32_t>(entry.value.size());
+      const char* type = property ? property->type() : "";
+      value.type = strings.add(type);
+      value.typeSize = static_cast<uint32_t>(strlen(type));
+      value.loaded = entry.loaded;
+      // the binary value is only meaningful if it was parsed from the stored text
+      value.kind = index.isSynced(slot) ? probeKind(property, value.bits) : KIND_STRING;
+      if (property && (property->flags & Property::CHECKSUM)) {
+        section.checksum ^= Properties_EntryChecksum(*entry.key, entry.value);
+      }
+      valueTable.push_back(value);
+    }
+    section.valueCount = static_cast<uint32_t>(valueTable.size()) - section.firstValue;
+    sectionTable.push_back(section);
+  }
+
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.headerSize = sizeof(Header);
+  header.sectionCount = static_cast<uint32_t>(sectionTable.size());
+  header.sectionTableOffset = static_cast<uint32_t>(align8(sizeof(Header)));
+  header.valueCount = static_cast<uint32_t>(valueTable.size());
+  header.valueTableOffset =
+      static_cast<uint32_t>(align8(header.sectionTableOffset + sectionTable.size() * sizeof(SectionEntry)));
+  header.stringTableOffset =
+      static_cast<uint32_t>(align8(header.valueTableOffset + valueTable.size() * sizeof(ValueEntry)));
+  header.stringTableSize = static_cast<uint32_t>(strings.data().size());
+
+  MEtl::string body(header.stringTableOffset + header.stringTableSize - sizeof(Header), '\0');
+  char* base = &body[0] - sizeof(Header);// offsets are relative to the start of the file
+  if (!sectionTable.empty()) {
+    memcpy(base + header.sectionTableOffset, sectionTable.data(), sectionTable.size() * sizeof(SectionEntry));
+  }
+  if (!valueTable.empty()) {
+    memcpy(base + header.valueTableOffset, valueTable.data(), valueTable.size() * sizeof(ValueEntry));
+  }
+  memcpy(base + header.stringTableOffset, strings.data().data(), strings.data().size());
+  header.checksum = Properties_Crc32c(body.data(), body.size());
+
+  MEtl::string tmpFile = MEtl::string(file) + ".tmp";
+  FILE* out = fopen(tmpFile.c_str(), "wb");
+  if (!out) {
+    errMsg = "can't open " + tmpFile + " for writing";
+    return false;
+  }
+  bool written = fwrite(&header, sizeof(header), 1, out) == 1 && fwrite(body.data(), 1, body.size(), out) == body.size();
+  written = (fclose(out) == 0) && written;
+  if (!written || rename(tmpFile.c_str(), file) != 0) {
+    remove(tmpFile.c_str());
+    errMsg = MEtl::string("can't write ") + file;
+    return false;
+  }
+  return true;
+}
+
+PropertiesBinary::PropertiesBinary()
+    : _header(nullptr) {}
+
+bool PropertiesBinary::open(const char* file, MEtl::string& errMsg) {
+  _header = nullptr;
+  if (!_mapped.open(file)) {
+    errMsg = MEtl::string("can't open ") + file;
+    return false;
+  }
+  const Header* header = reinterpret_cast<const Header*>(_mapped.data());
+  if (_mapped.size() < sizeof(Header) || memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+    errMsg = MEtl::string(file) + " is not a binary properties file";
+    return false;
+  }
+  if (header->version != VERSION || header->headerSize != sizeof(Header)) {
+    errMsg = MEtl::string(file) + " has an unsupported binary properties version";
+    return false;
+  }
+  uint64_t size = _mapped.size();
+  if (header->sectionTableOffset + static_cast<uint64_t>(header->sectionCount) * sizeof(SectionEntry) > size ||
+      header->valueTableOffset + static_cast<uint64_t>(header->valueCount) * sizeof(ValueEntry) > size ||
+      header->stringTableOffset + static_cast<uint64_t>(header->stringTableSize) != size) {
+    errMsg = MEtl::string(file) + " is truncated";
+    return false;
+  }
+  if (Properties_Crc32c(_mapped.data() + sizeof(Header), size - sizeof(Header)) != header->checksum) {
+    errMsg = MEtl::string(file) + " checksum mismatch";
+    return false;
+  }
+  _header = header;
+  return true;
+}
+
+std::string_view PropertiesBinary::string(uint32_t offset, uint32_t size) const {
+  if (static_cast<uint64_t>(offset) + size >= _header->stringTableSize) {
+    return std::string_view();
+  }
+  return std::string_view(_mapped.data() + _header->stringTableOffset + offset, size);
+}
+
+PropertiesBinary::Section PropertiesBinary::section(size_t i) const {
+  SectionEntry entry;
+  memcpy(&entry, _mapped.data() + _header->sectionTableOffset + i * sizeof(SectionEntry), sizeof(entry));
+  Section section;
+  section.name = string(entry.name, entry.nameSize);
+  section.firstValue = entry.firstValue;
+  section.valueCount = entry.valueCount;
+  section.checksum = entry.checksum;
+  if (section.firstValue + section.valueCount > _header->valueCount) {
+    section.valueCount = 0;
+  }
+  return section;
+}
+
+bool PropertiesBinary::findSection(std::string_view name, Section& section) const {
+  for (size_t i = 0; i < sections(); ++i) {
+    section = this->section(i);
+    if (section.name == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+PropertiesBinary::Value PropertiesBinary::value(size_t i) const {
+  ValueEntry entry;
+  memcpy(&entry, _mapped.data() + _header->valueTableOffset + i * sizeof(ValueEntry), sizeof(entry));
+  Value value;
+  value.key = string(entry.key, entry.keySize);
+  value.value = string(entry.value, entry.valueSize);
+  value.type = string(entry.type, entry.typeSize);
+  value.loaded = entry.loaded;
+  value.kind = entry.kind <= KIND_DOUBLE ? static_cast<ValueKind>(entry.kind) : KIND_STRING;
+  value.bits = entry.bits;
+  return value;
+}
+
+bool Properties::storeBinary(const MEtl::string& file, MEtl::string& errMsg) const {
+  return PropertiesBinary::store(file.c_str(), std::vector<const Properties*>(1, this), errMsg);
+}
+
+bool Properties::loadBinary(const MEtl::string& file, MEtl::string& errMsg, unsigned int source,
+                            const UInts* checksums) {
+  return loadBinary(file.c_str(), std::vector<Properties*>(1, this), errMsg, source, checksums);
+}
+
+bool Properties::loadBinary(const char* file, const std::vector<Properties*>& containers, MEtl::string& errMsg,
+                            unsigned int source, const UInts* checksums) {
+  PropertiesBinary binary;
+  if (!binary.open(file, errMsg)) {
+    return false;
+  }
+  bool ok = true;
+  for (size_t c = 0; c < containers.size(); ++c) {
+    Properties& properties = *containers[c];
+    const MEtl::string& name = properties.getName();
+    PropertiesBinary::Section section;
+    properties._sectionFound = binary.findSection(std::string_view(name.data(), name.size()), section);
+    if (!properties._sectionFound) {
+      continue;
+    }
+    std::vector<std::pair<MEtl::string, MEtl::string>> unknownFields;
+    for (size_t i = 0; i < section.valueCount; ++i) {
+      PropertiesBinary::Value value = binary.value(section.firstValue + i);
+      MEtl::string text(value.value.data(), value.value.size());
+      PropertiesIndex::Slot slot = properties._index.find(value.key.data(), value.key.size());
+      const Property* property = properties._index.property(slot);
+      if (!property || value.kind == PropertiesBinary::KIND_STRING) {
+        if (!properties._loadRecord(value.key, text, source, unknownFields)) {
+          ok = false;
+        }
+        continue;
+      }
+      // validated as text, then the stored binary value is assigned instead of parsing the text
+      MEtl::string from;
+      bool hadValue;
+      if (!properties._acceptValue(slot, text, from, hadValue)) {
+        ok = false;
+        continue;
+      }
+      bool assigned = assignBinary(property, value);
+      properties._storeValue(slot, text, source, from, hadValue, assigned);
+    }
+    // the stored section checksum is informational; the loaded values are checked like those of a text load
+    if (checksums) {
+      MEtl::string checksumErr;
+      if (!properties.validateChecksum(checksumErr, checksums)) {
+        errMsg += checksumErr;
+        ok = false;
+      }
+    }
+    properties._loadFinished(source, unknownFields);
+  }
+  return ok;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file PropertiesBinary.h
+ * @brief Versioned binary snapshot format of Properties values ("compiled config").
+ *
+ * Layout (all integers little endian, as written by the host):
+ *   Header        : magic, version, table counts/offsets, checksum of everything following the header
+ *   Section table : one entry per section - name, range in the value table, checksum of its CHECKSUM properties
+ *   Value table   : one entry per value - key, string value and type name, loaded bits, typed binary value
+ *   String table  : NUL terminated strings referenced by offset from the other tables
+ *
+ * The file is memory mapped and used in place; no parsing of text is involved in loading it.
+ */
+
+#ifndef __PROPERTIES_BINARY__H__
+#define __PROPERTIES_BINARY__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string_view>
+#include <vector>
+
+#include "PropertiesTokenizer.h"
+
+class Properties;
+
+/**
+ * @class PropertiesBinary
+ * @brief Writer and memory-mapped reader of the binary snapshot format.
+ */
+class PropertiesBinary {
+public:
+  static const uint32_t VERSION = 1;
+
+  /// @brief The kind of the typed binary value of an entry.
+  enum ValueKind {
+    KIND_STRING = 0, /** < only the string value is available (free keys, non scalar types)*/
+    KIND_BOOL = 1,
+    KIND_INT = 2,    /** < signed integer, bits hold an int64_t*/
+    KIND_UINT = 3,   /** < unsigned integer, bits hold a uint64_t*/
+    KIND_DOUBLE = 4  /** < floating point, bits hold a double*/
+  };
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t sectionCount;
+    uint32_t sectionTableOffset;
+    uint32_t valueCount;
+    uint32_t valueTableOffset;
+    uint32_t stringTableOffset;
+    uint32_t stringTableSize;
+    uint32_t checksum; /** < CRC32C of the file following the header.*/
+    uint32_t reserved;
+  };
+
+  struct SectionEntry {
+    uint32_t name; /** < String table offset of the section name.*/
+    uint32_t nameSize;
+    uint32_t firstValue;
+    uint32_t valueCount;
+    uint32_t checksum; /** < XOR of Properties_EntryChecksum() of the section's CHECKSUM flagged properties.*/
+    uint32_t reserved;
+  };
+
+  struct ValueEntry {
+    uint32_t key; /** < String table offsets and sizes.*/
+    uint32_t keySize;
+    uint32_t value;
+    uint32_t valueSize;
+    uint32_t type;
+    uint32_t typeSize;
+    uint32_t loaded; /** < Property::Loaded bits at store time.*/
+    uint32_t kind;   /** < ValueKind.*/
+    uint64_t bits;   /** < The typed binary value, see ValueKind.*/
+  };
+
+  /// @brief A value of a mapped file; the string views point into the mapping.
+  struct Value {
+    std::string_view key;
+    std::string_view value;
+    std::string_view type;
+    unsigned int loaded;
+    ValueKind kind;
+    uint64_t bits;
+  };
+
+  /// @brief A section of a mapped file.
+  struct Section {
+    std::string_view name;
+    size_t firstValue;
+    size_t valueCount;
+    uint32_t checksum;
+  };
+
+  /**
+   * @brief Write the values of the given Properties objects to a binary file, one section per object.
+   *
+   * The file is written next to its final name and renamed into place, so readers never see a partial file.
+   *
+   * @param[in] file The path of the file to write.
+   * @param[in] containers The Properties objects to store; each is stored under its section name.
+   * @param[out] errMsg Receives the reason of a failure.
+   * @return true if the file was written.
+   */
+  static bool store(const char* file, const std::vector<const Properties*>& containers, MEtl::string& errMsg);
+
+  PropertiesBinary();
+
+  /**
+   * @brief Map a binary file and verify its header, bounds and checksum.
+   *
+   * @param[in] file The path of the file to open.
+   * @param[out] errMsg Receives the reason of a failure.
+   * @return true if the file is a valid binary snapshot of this version.
+   */
+  bool open(const char* file, MEtl::string& errMsg);
+
+  size_t sections() const { return _header ? _header->sectionCount : 0; }
+  Section section(size_t i) const;
+
+  /**
+   * @brief Find a section by name.
+   *
+   * @param[in] name The section name as stored (Properties::getName()).
+   * @param[out] section The section, if found.
+   * @return true if the file has the section.
+   */
+  bool findSection(std::string_view name, Section& section) const;
+
+  Value value(size_t i) const;
+
+private:
+  std::string_view string(uint32_t offset, uint32_t size) const;
+
+  MappedFile _mapped;
+  const Header* _header;
+};
+
+#endif//__PROPERTIES_BINARY__H__
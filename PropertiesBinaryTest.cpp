@@ -0,0 +1,196 @@
+/**
+ * @file PropertiesBinaryTest.cpp
+ * @brief Tests of the binary snapshot format: round trips through storeBinary() and loadBinary(), and rejection of
+ *        damaged files.
+ */
+
+#include "Properties.h"
+#include "PropertiesBinary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+struct BinaryProperties : public Properties {
+  explicit BinaryProperties(const char* section)
+      : Properties(section)
+      , count(this, -3, "count", "a signed value", Property::DEFAULT_FLAGS)
+      , size(this, 7u, "size", "an unsigned value", Property::DEFAULT_FLAGS)
+      , ratio(this, 0.5, "ratio", "a floating point value", Property::DEFAULT_FLAGS | Property::CHECKSUM)
+      , enabled(this, false, "enabled", "a flag", Property::DEFAULT_FLAGS)
+      , label(this, "none", "label", "a string", Property::DEFAULT_FLAGS) {}
+  ProperT<int> count;
+  ProperT<unsigned int> size;
+  ProperT<double> ratio;
+  ProperT<bool> enabled;
+  ProperT<MEtl::string> label;
+};
+
+MEtl::string tempName() {
+  char name[] = "/tmp/PropertiesBinaryTestXXXXXX";
+  int fd = mkstemp(name);
+  if (fd >= 0) {
+    close(fd);
+  }
+  return MEtl::string(name);
+}
+
+std::string stored(const Properties& properties) {
+  std::ostringstream out;
+  properties.store(out, Properties::STORE_FREE_PARAMS, '=');
+  return out.str();
+}
+
+void fill(BinaryProperties& properties) {
+  properties.load(MEtl::string("count=-42\nsize=4000000000\nratio=0.1\nenabled=1\nlabel=a b\nfree=text\n"), '=');
+}
+
+void testRoundTrip() {
+  const MEtl::string file = tempName();
+  BinaryProperties original("binary");
+  fill(original);
+  MEtl::string errMsg;
+  CHECK(original.storeBinary(file, errMsg));
+
+  BinaryProperties loaded("binary");
+  CHECK(loaded.loadBinary(file, errMsg));
+  CHECK(loaded.getLastLoadCallSectionFound());
+  CHECK(stored(loaded) == stored(original));
+  CHECK(loaded.getProperty(MEtl::string("count"), 0) == -42);
+  CHECK(loaded.getProperty(MEtl::string("size"), 0u) == 4000000000u);
+  // the binary value is assigned as stored, so the double survives exactly
+  CHECK(loaded.getProperty(MEtl::string("ratio"), 0.0) == 0.1);
+  CHECK(loaded.getProperty(MEtl::string("enabled"), false));
+  CHECK(loaded.getProperty(MEtl::string("label"), MEtl::string()) == MEtl::string("a b"));
+  CHECK(loaded.getProperty(MEtl::string("free"), MEtl::string()) == MEtl::string("text"));
+  CHECK(loaded.checksum() == original.checksum());
+
+  // a section that is not in the file is not found and changes nothing
+  BinaryProperties other("other");
+  CHECK(other.loadBinary(file, errMsg));
+  CHECK(!other.getLastLoadCallSectionFound());
+  CHECK(other.getProperty(MEtl::string("count"), 0) == -3);
+  unlink(file.c_str());
+}
+
+void testReader() {
+  const MEtl::string file = tempName();
+  BinaryProperties first("first");
+  BinaryProperties second("second");
+  fill(first);
+  std::vector<const Properties*> containers;
+  containers.push_back(&first);
+  containers.push_back(&second);
+  MEtl::string errMsg;
+  CHECK(PropertiesBinary::store(file.c_str(), containers, errMsg));
+
+  PropertiesBinary binary;
+  CHECK(binary.open(file.c_str(), errMsg));
+  CHECK(binary.sections() == 2);
+  PropertiesBinary::Section section;
+  CHECK(binary.findSection("first", section));
+  CHECK(section.checksum == first.checksum());
+  bool found = false;
+  for (size_t i = section.firstValue; i < section.firstValue + section.valueCount; ++i) {
+    PropertiesBinary::Value value = binary.value(i);
+    if (value.key == "count") {
+      found = true;
+      CHECK(value.value == "-42");
+      // the binary value is stored for synced properties only
+      CHECK(value.kind == PropertiesBinary::KIND_INT || value.kind == PropertiesBinary::KIND_STRING);
+      if (value.kind == PropertiesBinary::KIND_INT) {
+        CHECK(static_cast<int64_t>(value.bits) == -42);
+      }
+      CHECK(value.loaded == Property::FROM_INF);
+    }
+    if (value.key == "free") {
+      CHECK(value.kind == PropertiesBinary::KIND_STRING);
+    }
+  }
+  CHECK(found);
+  CHECK(!binary.findSection("missing", section));
+
+  // every object loads its own section
+  BinaryProperties loadedFirst("first");
+  BinaryProperties loadedSecond("second");
+  std::vector<Properties*> targets;
+  targets.push_back(&loadedFirst);
+  targets.push_back(&loadedSecond);
+  CHECK(Properties::loadBinary(file.c_str(), targets, errMsg));
+  CHECK(stored(loadedFirst) == stored(first));
+  CHECK(stored(loadedSecond) == stored(second));
+  unlink(file.c_str());
+}
+
+void testDamaged() {
+  const MEtl::string file = tempName();
+  BinaryProperties original("binary");
+  fill(original);
+  MEtl::string errMsg;
+  CHECK(original.storeBinary(file, errMsg));
+  FILE* in = fopen(file.c_str(), "rb");
+  std::vector<char> bytes;
+  if (in) {
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+      bytes.insert(bytes.end(), buf, buf + n);
+    }
+    fclose(in);
+  }
+  CHECK(bytes.size() > sizeof(PropertiesBinary::Header));
+
+  const size_t flips[] = { 0, sizeof(PropertiesBinary::Header), bytes.size() - 1 };
+  for (size_t f = 0; f < sizeof(flips) / sizeof(flips[0]); ++f) {
+    std::vector<char> damaged(bytes);
+    damaged[flips[f]] ^= 0x20;
+    FILE* out = fopen(file.c_str(), "wb");
+    fwrite(damaged.data(), 1, damaged.size(), out);
+    fclose(out);
+    PropertiesBinary binary;
+    errMsg.clear();
+    CHECK(!binary.open(file.c_str(), errMsg));
+    CHECK(!errMsg.empty());
+    BinaryProperties loaded("binary");
+    CHECK(!loaded.loadBinary(file, errMsg));
+    // nothing is applied from a damaged file
+    CHECK(loaded.getProperty(MEtl::string("count"), 0) == -3);
+  }
+
+  FILE* out = fopen(file.c_str(), "wb");
+  fwrite(bytes.data(), 1, bytes.size() / 2, out);
+  fclose(out);
+  PropertiesBinary truncated;
+  CHECK(!truncated.open(file.c_str(), errMsg));
+  unlink(file.c_str());
+  PropertiesBinary missing;
+  CHECK(!missing.open(file.c_str(), errMsg));
+}
+}// namespace
+
+int main() {
+  testRoundTrip();
+  testReader();
+  testDamaged();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file PropertiesBulkLoad.cpp
+ * @brief Loading of several Properties objects from a single scan of their sources.
+ */
+
+#include "Properties.h"
+#include "PropertiesParallel.h"
+#include "PropertiesSectionIndex.h"
+#include "PropertiesTokenizer.h"
+
+#include <chrono>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+struct LoadTarget {
+  Properties* properties;
+  std::vector<std::pair<MEtl::string, MEtl::string>> unknownFields;
+  bool ok;
+};
+
+struct TokenizedFile {
+  MappedFile mapped;
+  std::vector<IniRecord> records;
+  bool sectionFound;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}// namespace
+
+bool Properties::loadFile(const char* file, char sep, const std::vector<Properties*>& containers,
+                          unsigned int source) {
+  MappedFile mapped;
+  if (!mapped.open(file)) {
+    for (size_t i = 0; i < containers.size(); ++i) {
+      containers[i]->_err << "ERROR: can't open file " << file << "\n";
+    }
+    return false;
+  }
+  IniTokenizer tokenizer(mapped.view(), sep, true);
+  return loadRecords(tokenizer, containers, source);
+}
+
+bool Properties::_loadRecord(std::string_view key, const MEtl::string& value, unsigned int source,
+                             std::vector<std::pair<MEtl::string, MEtl::string>>& unknownFields) {
+  PropertiesIndex::Slot slot = _index.find(key.data(), key.size());
+  if (!_index.property(slot)) {
+    MEtl::string name(key.data(), key.size());
+    inspectUnknownFields(name, value, source, unknownFields);
+    // a free parameter is kept with its source bits, as load() does, so properties() and STORE_FREE_PARAMS see it
+    return _setProperty(name, value, source);
+  }
+  return _setProperty(slot, value, source);
+}
+
+void Properties::_loadFinished(unsigned int source,
+                               std::vector<std::pair<MEtl::string, MEtl::string>>& unknownFields) {
+  if (!unknownFields.empty()) {
+    handleUnknownFields(source, unknownFields);
+  }
+  if (_sectionFound) {
+    _loaded |= source;
+    notifyChanged();
+    onLoaded();
+    postLoaded();
+    publishSnapshot();
+  }
+}
+
+bool Properties::loadRecords(IniTokenizer& tokenizer, const std::vector<Properties*>& containers,
+                             unsigned int source) {
+  std::vector<LoadTarget> targets(containers.size());
+  std::unordered_map<std::string_view, std::vector<LoadTarget*>> routes;
+  for (size_t i = 0; i < containers.size(); ++i) {
+    targets[i].properties = containers[i];
+    targets[i].ok = true;
+    containers[i]->_sectionFound = false;
+    const MEtl::string& name = containers[i]->getName();
+    routes[std::string_view(name.data(), name.size())].push_back(&targets[i]);
+  }
+
+  // records of the same section are consecutive, so the route is looked up once per section
+  std::vector<LoadTarget*>* route = nullptr;
+  bool first = true;
+  std::string_view section;
+  IniRecord record;
+  while (tokenizer.next(record)) {
+    if (first || record.section.data() != section.data() || record.section.size() != section.size()) {
+      first = false;
+      section = record.section;
+      auto it = routes.find(section);
+      route = (it == routes.end()) ? nullptr : &it->second;
+      if (route) {
+        for (size_t i = 0; i < route->size(); ++i) {
+          (*route)[i]->properties->_sectionFound = true;
+        }
+      }
+    }
+    if (!route || record.header) {
+      continue;
+    }
+    MEtl::string value(record.value.data(), record.value.size());
+    for (size_t i = 0; i < route->size(); ++i) {
+      LoadTarget& target = *(*route)[i];
+      if (!target.properties->_loadRecord(record.key, value, source, target.unknownFields)) {
+        target.ok = false;
+      }
+    }
+  }
+
+  bool ok = true;
+  for (size_t i = 0; i < targets.size(); ++i) {
+    targets[i].properties->_loadFinished(source, targets[i].unknownFields);
+    ok = ok && targets[i].ok;
+  }
+  return ok;
+}
+
+bool Properties::load(const PropertiesSectionIndex& index, char sep, const char* section, unsigned int source) {
+  std::string_view data = index.buffer();
+  if (section) {
+    const PropertiesSectionIndex::Section* found = index.find(section);
+    if (!found) {
+      resetLastLoadCallSectionFound();
+      return true;
+    }
+    data = data.substr(found->dataOffset, found->dataSize);
+  }
+  setLastLoadCallSectionFound();
+  // the records are applied directly, so the hooks run once, after the changes were reported
+  bool ok = true;
+  std::vector<std::pair<MEtl::string, MEtl::string>> unknownFields;
+  IniTokenizer tokenizer(data, sep);
+  IniRecord record;
+  while (tokenizer.next(record)) {
+    if (!_loadRecord(record.key, MEtl::string(record.value.data(), record.value.size()), source, unknownFields)) {
+      ok = false;
+    }
+  }
+  _loadFinished(source, unknownFields);
+  return ok;
+}
+
+bool Properties::loadFile(const Strings& multiFile, char sep, const char* section, unsigned int source,
+                          unsigned int threads, std::vector<FileLoadTiming>* timings) {
+  std::vector<TokenizedFile> files(multiFile.size());
+  std::vector<FileLoadTiming> fileTimings(multiFile.size());
+  std::string_view wanted = section ? PropertiesSectionIndex::stripBrackets(section) : std::string_view();
+
+  // read and tokenize concurrently; nothing is applied to this object yet
+  Properties_ParallelFor(multiFile.size(), threads, [&](size_t i) {
+    FileLoadTiming& timing = fileTimings[i];
+    TokenizedFile& file = files[i];
+    timing.file = multiFile[i];
+    timing.records = 0;
+    timing.applyMs = 0;
+    file.sectionFound = false;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    timing.ok = file.mapped.open(multiFile[i].c_str());
+    timing.readMs = millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    IniTokenizer tokenizer(file.mapped.view(), sep, true);
+    IniRecord record;
+    while (timing.ok && tokenizer.next(record)) {
+      if (section && PropertiesSectionIndex::stripBrackets(record.section) != wanted) {
+        continue;
+      }
+      file.sectionFound = true;
+      if (!record.header) {
+        file.records.push_back(record);
+      }
+    }
+    timing.records = file.records.size();
+    timing.tokenizeMs = millisecondsSince(start);
+  });
+
+  // apply in the given order, so later files override earlier ones exactly as in the sequential load
+  bool ok = true;
+  _sectionFound = false;
+  std::vector<std::pair<MEtl::string, MEtl::string>> unknownFields;
+  for (size_t i = 0; i < files.size(); ++i) {
+    FileLoadTiming& timing = fileTimings[i];
+    if (!timing.ok) {
+      _err << "ERROR: can't open file " << multiFile[i] << "\n";
+      ok = false;
+      continue;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const std::vector<IniRecord>& records = files[i].records;
+    for (size_t r = 0; r < records.size(); ++r) {
+      MEtl::string value(records[r].value.data(), records[r].value.size());
+      if (!_loadRecord(records[r].key, value, source, unknownFields)) {
+        timing.ok = false;
+      }
+    }
+    _sectionFound = _sectionFound || files[i].sectionFound;
+    ok = ok && timing.ok;
+    timing.applyMs = millisecondsSince(start);
+    files[i].mapped.close();
+  }
+  _loadFinished(source, unknownFields);
+
+  if (_verbose >= MID) {
+    for (size_t i = 0; i < fileTimings.size(); ++i) {
+      const FileLoadTiming& timing = fileTimings[i];
+      _out << "loaded " << timing.file << ": " << timing.records << " records, read " << timing.readMs
+           << " ms, tokenize " << timing.tokenizeMs << " ms, apply " << timing.applyMs << " ms"
+           << (timing.ok ? "" : " (FAILED)") << "\n";
+    }
+  }
+  if (timings) {
+    timings->swap(fileTimings);
+  }
+  return ok;
+}
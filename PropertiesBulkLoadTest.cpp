@@ -0,0 +1,154 @@
+/**
+ * @file PropertiesBulkLoadTest.cpp
+ * @brief Tests of the single pass and concurrent loaders: keys no property is registered for are kept as free
+ *        parameters, and the files of a concurrent load are applied in their given order.
+ */
+
+#include "Properties.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+struct BulkProperties : public Properties {
+  explicit BulkProperties(const char* section)
+      : Properties(section)
+      , count(this, 1, "count", "a registered value", Property::DEFAULT_FLAGS) {}
+  ProperT<int> count;
+};
+
+const char* const INI = "[first]\n"
+                        "count=3\n"
+                        "free=kept\n"
+                        "[second]\n"
+                        "count=4\n"
+                        "other=also kept\n";
+
+bool writeFile(char* name, const char* contents = INI) {
+  int fd = mkstemp(name);
+  if (fd < 0) {
+    return false;
+  }
+  const std::string text(contents);
+  const bool ok = write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size());
+  close(fd);
+  return ok;
+}
+
+void testSinglePass() {
+  char name[] = "/tmp/PropertiesBulkLoadTestXXXXXX";
+  CHECK(writeFile(name));
+  BulkProperties first("first");
+  BulkProperties second("second");
+  std::vector<Properties*> containers;
+  containers.push_back(&first);
+  containers.push_back(&second);
+  CHECK(Properties::loadFile(name, '=', containers));
+  unlink(name);
+
+  CHECK(first.getProperty(MEtl::string("count"), 0) == 3);
+  CHECK(second.getProperty(MEtl::string("count"), 0) == 4);
+  bool exist = false;
+  CHECK(first.getProperty(MEtl::string("free"), MEtl::string(), &exist) == MEtl::string("kept"));
+  CHECK(exist);
+  CHECK(second.getProperty(MEtl::string("other"), MEtl::string(), &exist) == MEtl::string("also kept"));
+  CHECK(exist);
+  // records are routed by section only
+  first.getProperty(MEtl::string("other"), MEtl::string(), &exist);
+  CHECK(!exist);
+
+  // the free parameters are stored with their source, as after load()
+  std::ostringstream out;
+  first.store(out, Properties::STORE_FREE_PARAMS, '=');
+  CHECK(out.str().find("free=kept") != std::string::npos);
+}
+
+void testSameAsLoad() {
+  char name[] = "/tmp/PropertiesBulkLoadTestXXXXXX";
+  CHECK(writeFile(name));
+  BulkProperties bulk("first");
+  CHECK(Properties::loadFile(name, '=', std::vector<Properties*>(1, &bulk)));
+  BulkProperties loaded("first");
+  CHECK(loaded.loadFile(name, '=', "first"));
+  unlink(name);
+
+  for (int flags = 0; flags < 2; ++flags) {
+    std::ostringstream expected;
+    loaded.store(expected, flags * Properties::STORE_FREE_PARAMS, '=');
+    std::ostringstream actual;
+    bulk.store(actual, flags * Properties::STORE_FREE_PARAMS, '=');
+    CHECK(actual.str() == expected.str());
+  }
+}
+
+void testParallelFiles() {
+  char first[] = "/tmp/PropertiesBulkLoadTestXXXXXX";
+  char second[] = "/tmp/PropertiesBulkLoadTestXXXXXX";
+  CHECK(writeFile(first));
+  CHECK(writeFile(second, "[first]\ncount=5\nlater=yes\n"));
+  Strings files;
+  files.push_back(first);
+  files.push_back(second);
+
+  for (unsigned int threads = 0; threads <= 4; ++threads) {
+    BulkProperties sequential("first");
+    CHECK(sequential.loadFile(files, '=', "first"));
+    BulkProperties parallel("first");
+    std::vector<Properties::FileLoadTiming> timings;
+    CHECK(parallel.loadFile(files, '=', "first", Property::FROM_INF, threads, &timings));
+    // the later file overrides the earlier one, as in the sequential load
+    CHECK(parallel.getProperty(MEtl::string("count"), 0) == 5);
+    CHECK(parallel.getProperty(MEtl::string("free"), MEtl::string()) == MEtl::string("kept"));
+    CHECK(parallel.getProperty(MEtl::string("later"), MEtl::string()) == MEtl::string("yes"));
+    std::ostringstream expected;
+    sequential.store(expected, Properties::STORE_FREE_PARAMS, '=');
+    std::ostringstream actual;
+    parallel.store(actual, Properties::STORE_FREE_PARAMS, '=');
+    CHECK(actual.str() == expected.str());
+
+    CHECK(timings.size() == 2);
+    if (timings.size() == 2) {
+      CHECK(timings[0].file == MEtl::string(first));
+      CHECK(timings[0].records == 2);
+      CHECK(timings[1].records == 2);
+      CHECK(timings[0].ok && timings[1].ok);
+    }
+  }
+
+  // a missing file fails the load, the other files are still applied
+  unlink(second);
+  BulkProperties missing("first");
+  std::vector<Properties::FileLoadTiming> timings;
+  CHECK(!missing.loadFile(files, '=', "first", Property::FROM_INF, 2, &timings));
+  CHECK(missing.getProperty(MEtl::string("count"), 0) == 3);
+  CHECK(timings.size() == 2 && timings[0].ok && !timings[1].ok);
+  unlink(first);
+}
+}// namespace
+
+int main() {
+  testSinglePass();
+  testSameAsLoad();
+  testParallelFiles();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
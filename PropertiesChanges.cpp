@@ -0,0 +1,36 @@
+/**
+ * @file PropertiesChanges.cpp
+ * @brief Change tracking of Properties values between loads.
+ */
+
+#include "Properties.h"
+
+size_t Properties::notifyChanged(std::vector<MEtl::string>* changedKeys) {
+  std::vector<PropertiesIndex::Slot> slots;
+  _index.takeChanged(slots);
+  if (slots.empty()) {
+    if (changedKeys) {
+      changedKeys->clear();
+    }
+    return 0;
+  }
+  std::vector<MEtl::string> keys;
+  keys.reserve(slots.size());
+  for (size_t i = 0; i < slots.size(); ++i) {
+    const PropertiesIndex::Entry& entry = _index.at(slots[i]);
+    const Property* property = _index.property(slots[i]);
+    if (property && (entry.flags & PropertiesIndex::HAS_VALUE)) {
+      property->sync(entry.value);
+      if (!property->verifyValIfRequired()) {
+        _err << "WARNING: verification of " << *entry.key << " failed after it was changed\n";
+      }
+    }
+    keys.push_back(*entry.key);
+  }
+  onModifiedBatch(keys);
+  if (changedKeys) {
+    changedKeys->swap(keys);
+    return changedKeys->size();
+  }
+  return keys.size();
+}
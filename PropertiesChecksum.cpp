@@ -0,0 +1,92 @@
+/**
+ * @file PropertiesChecksum.cpp
+ */
+
+#include "PropertiesChecksum.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define PROPERTIES_CRC32C_HARDWARE 1
+#endif
+
+namespace {
+const uint32_t CRC32C_POLY = 0x82F63B78u;// reflected Castagnoli polynomial
+
+struct Crc32cTable {
+  uint32_t table[256];
+  Crc32cTable() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+      }
+      table[i] = crc;
+    }
+  }
+};
+
+const Crc32cTable& crc32cTable() {
+  static const Crc32cTable table;
+  return table;
+}
+
+uint32_t crc32cSoftware(const unsigned char* bytes, size_t size, uint32_t crc) {
+  const uint32_t* table = crc32cTable().table;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(PROPERTIES_CRC32C_HARDWARE)
+/// @brief CRC32C with the SSE4.2 crc32 instruction, 8 bytes per step. Only called if the CPU supports SSE4.2.
+__attribute__((target("sse4.2"))) uint32_t crc32cHardware(const unsigned char* bytes, size_t size, uint32_t crc) {
+  for (; size && (reinterpret_cast<uintptr_t>(bytes) & 7); --size, ++bytes) {
+    crc = _mm_crc32_u8(crc, *bytes);
+  }
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+  for (; size >= 8; size -= 8, bytes += 8) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+  for (; size >= 4; size -= 4, bytes += 4) {
+    uint32_t word;
+    memcpy(&word, bytes, sizeof(word));
+    crc = _mm_crc32_u32(crc, word);
+  }
+  for (; size; --size, ++bytes) {
+    crc = _mm_crc32_u8(crc, *bytes);
+  }
+  return crc;
+}
+#endif
+
+typedef uint32_t (*Crc32cFunction)(const unsigned char* bytes, size_t size, uint32_t crc);
+
+// chosen once at run time, so a generic build still uses the instruction where the CPU has it
+Crc32cFunction selectCrc32c() {
+#if defined(PROPERTIES_CRC32C_HARDWARE)
+  if (__builtin_cpu_supports("sse4.2")) {
+    return &crc32cHardware;
+  }
+#endif
+  return &crc32cSoftware;
+}
+}// namespace
+
+uint32_t Properties_Crc32c(const void* data, size_t size, uint32_t crc) {
+  static const Crc32cFunction crc32c = selectCrc32c();
+  return ~crc32c(static_cast<const unsigned char*>(data), size, ~crc);
+}
+
+uint32_t Properties_EntryChecksum(std::string_view key, std::string_view value) {
+  uint32_t crc = Properties_Crc32c(key.data(), key.size());
+  crc = Properties_Crc32c("=", 1, crc);
+  return Properties_Crc32c(value.data(), value.size(), crc);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file PropertiesChecksum.h
+ */
+
+#ifndef __PROPERTIES_CHECKSUM__H__
+#define __PROPERTIES_CHECKSUM__H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string_view>
+
+/**
+ * @brief Computes the CRC32C (Castagnoli) of a buffer.
+ *
+ * @param[in] data The buffer.
+ * @param[in] size The size of the buffer in bytes.
+ * @param[in] crc The CRC of the preceding data, to checksum a buffer in pieces (default: 0).
+ *
+ * @return The CRC32C of the preceding data followed by the buffer.
+ */
+extern uint32_t Properties_Crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+/**
+ * @brief Computes the checksum contribution of a single "key=value" entry.
+ *
+ * The checksum of a set of entries is the XOR of the contributions of its entries. It does not depend on the order of
+ * the entries, and replacing an entry only requires XOR-ing out its old contribution and XOR-ing in the new one.
+ *
+ * @param[in] key The key of the entry.
+ * @param[in] value The value of the entry.
+ *
+ * @return The CRC32C of "key=value".
+ */
+extern uint32_t Properties_EntryChecksum(std::string_view key, std::string_view value);
+
+#endif//__PROPERTIES_CHECKSUM__H__
@@ -0,0 +1,85 @@
+/**
+ * @file PropertiesChecksumTest.cpp
+ * @brief Tests of Properties_Crc32c() and Properties_EntryChecksum() against a bitwise reference CRC32C.
+ */
+
+#include "PropertiesChecksum.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+uint32_t referenceCrc32c(const unsigned char* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+
+void testKnownValues() {
+  // the check value of CRC-32C
+  CHECK(Properties_Crc32c("123456789", 9) == 0xE3069283u);
+  CHECK(Properties_Crc32c("", 0) == 0);
+  std::vector<unsigned char> zeros(32, 0);
+  CHECK(Properties_Crc32c(zeros.data(), zeros.size()) == 0x8A9136AAu);
+}
+
+void testEveryLengthAndAlignment() {
+  std::vector<unsigned char> data(300);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<unsigned char>(i * 131 + 7);
+  }
+  // unaligned heads and tails of every size go through all steps of the hardware path
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t size = 0; offset + size <= data.size(); size += 1 + size / 16) {
+      CHECK(Properties_Crc32c(data.data() + offset, size) == referenceCrc32c(data.data() + offset, size));
+    }
+  }
+}
+
+void testPieces() {
+  const std::string text("a longer buffer that is checksummed in pieces of different sizes");
+  const uint32_t whole = Properties_Crc32c(text.data(), text.size());
+  for (size_t split = 0; split <= text.size(); ++split) {
+    uint32_t crc = Properties_Crc32c(text.data(), split);
+    CHECK(Properties_Crc32c(text.data() + split, text.size() - split, crc) == whole);
+  }
+}
+
+void testEntryChecksum() {
+  const std::string entry("key=value");
+  CHECK(Properties_EntryChecksum("key", "value") == Properties_Crc32c(entry.data(), entry.size()));
+  CHECK(Properties_EntryChecksum("key", "") == Properties_Crc32c("key=", 4));
+  CHECK(Properties_EntryChecksum("a", "1") != Properties_EntryChecksum("a", "2"));
+  CHECK(Properties_EntryChecksum("a", "1") != Properties_EntryChecksum("b", "1"));
+}
+}// namespace
+
+int main() {
+  testKnownValues();
+  testEveryLengthAndAlignment();
+  testPieces();
+  testEntryChecksum();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file PropertiesCommandLine.cpp
+ */
+
+#include "PropertiesCommandLine.h"
+#include "Properties.h"
+#include "PropertiesSectionIndex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace {
+const size_t NO_SECTION = static_cast<size_t>(-1);
+}
+
+PropertiesCommandLine::PropertiesCommandLine(int argc, char* argv[], BadCmdLineSyntaxPolicy policy) {
+  size_t current = NO_SECTION;
+  // argv[0] is the program name
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg(argv[i] ? argv[i] : "");
+    size_t eq = arg.find('=');
+    if (eq == std::string_view::npos) {
+      if (arg.size() < 2 || arg.back() != ':') {
+        _badSyntax.push_back(i);
+        continue;
+      }
+      std::string_view name = PropertiesSectionIndex::stripBrackets(arg.substr(0, arg.size() - 1));
+      auto found = _byName.find(name);
+      if (found == _byName.end()) {
+        found = _byName.insert(std::make_pair(name, _sections.size())).first;
+        _sections.push_back(Section());
+        _sections.back().name = name;
+      }
+      current = found->second;
+      continue;
+    }
+    if (eq == 0) {
+      _badSyntax.push_back(i);
+      continue;
+    }
+    if (current == NO_SECTION) {
+      // properties before the first section header
+      current = _sections.size();
+      _byName.insert(std::make_pair(std::string_view(), current));
+      _sections.push_back(Section());
+    }
+    Argument argument;
+    argument.key = arg.substr(0, eq);
+    argument.value = arg.substr(eq + 1);
+    argument.position = i;
+    _sections[current].arguments.push_back(argument);
+    _arguments.push_back(argument);
+  }
+  if (policy == IGNORE_ON_BAD_SYNTAX || _badSyntax.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < _badSyntax.size(); ++i) {
+    fprintf(stderr, "%s: bad command line syntax in argument %d: \"%s\" (expected <section>: or <key>=<value>)\n",
+            policy == ABORT_ON_BAD_SYNTAX ? "ERROR" : "WARNING", _badSyntax[i],
+            argv[_badSyntax[i]] ? argv[_badSyntax[i]] : "");
+  }
+  if (policy == ABORT_ON_BAD_SYNTAX) {
+    abort();
+  }
+}
+
+const PropertiesCommandLine::Section* PropertiesCommandLine::find(std::string_view section) const {
+  auto found = _byName.find(PropertiesSectionIndex::stripBrackets(section));
+  return found == _byName.end() ? nullptr : &_sections[found->second];
+}
+
+bool Properties::load(const PropertiesCommandLine& commandLine, const char* section) {
+  const std::vector<PropertiesCommandLine::Argument>* arguments = &commandLine.arguments();
+  if (section) {
+    const PropertiesCommandLine::Section* found = commandLine.find(section);
+    arguments = found ? &found->arguments : nullptr;
+  }
+  _sectionFound = (arguments != nullptr);
+  bool ok = true;
+  std::vector<std::pair<MEtl::string, MEtl::string>> unknownFields;
+  if (arguments) {
+    for (size_t i = 0; i < arguments->size(); ++i) {
+      const PropertiesCommandLine::Argument& argument = (*arguments)[i];
+      if (!_loadRecord(argument.key, MEtl::string(argument.value.data(), argument.value.size()), Property::FROM_ARGS,
+                       unknownFields)) {
+        ok = false;
+      }
+    }
+  }
+  _loadFinished(Property::FROM_ARGS, unknownFields);
+  return ok;
+}
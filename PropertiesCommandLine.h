@@ -0,0 +1,78 @@
+/**
+ * @file PropertiesCommandLine.h
+ */
+
+#ifndef __PROPERTIES_COMMAND_LINE__H__
+#define __PROPERTIES_COMMAND_LINE__H__
+
+#include <stddef.h>
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Properties.h"
+
+/**
+ * @class PropertiesCommandLine
+ * @brief A build-once index of command line arguments by section.
+ *
+ * The arguments are classified once on construction: "<section name>:" starts a section, "<key>=<value>" is a
+ * property of the current section (arguments before the first section header belong to the unnamed section ""),
+ * anything else is recorded as having bad syntax and reported according to the BadCmdLineSyntaxPolicy. argv[0], the
+ * program name, is skipped. A section named more than once collects the properties of all its occurrences, in command
+ * line order. Section names are accepted with or without their square brackets.
+ *
+ * Each Properties object then loads its slice with a single lookup (@see Properties::load(const PropertiesCommandLine&,
+ * const char*)), instead of converting the command line to INI text and parsing it again for every object.
+ *
+ * The index refers to argv and does not copy it: the arguments must outlive the index and must not be modified.
+ */
+class PropertiesCommandLine {
+public:
+  struct Argument {
+    std::string_view key;
+    std::string_view value;
+    int position; /** < The index of the argument in argv.*/
+  };
+
+  struct Section {
+    std::string_view name;           /** < The section name without its ':' and brackets.*/
+    std::vector<Argument> arguments; /** < The properties of the section, in command line order.*/
+  };
+
+  /**
+   * @brief Index a command line.
+   *
+   * @param[in] argc The size of argv.
+   * @param[in] argv The program name followed by the arguments.
+   * @param[in] policy What to do with arguments of bad syntax: ignore them, print their positions to stderr, or print
+   *                   their positions and abort (default: WARN_ON_BAD_SYNTAX).
+   */
+  PropertiesCommandLine(int argc, char* argv[], BadCmdLineSyntaxPolicy policy = WARN_ON_BAD_SYNTAX);
+
+  /**
+   * @brief Find a section by name.
+   *
+   * @param[in] section The section name, without its ':', with or without brackets.
+   * @return The section, or nullptr if the command line has no such section.
+   */
+  const Section* find(std::string_view section) const;
+
+  /// @brief Get the sections in their order of first appearance.
+  const std::vector<Section>& sections() const { return _sections; }
+
+  /// @brief Get all properties of all sections, in command line order.
+  const std::vector<Argument>& arguments() const { return _arguments; }
+
+  /// @brief Get the argv positions of the arguments that are neither a section header nor a property.
+  const std::vector<int>& badSyntax() const { return _badSyntax; }
+
+private:
+  std::vector<Section> _sections;
+  std::vector<Argument> _arguments;
+  std::vector<int> _badSyntax;
+  std::unordered_map<std::string_view, size_t> _byName;
+};
+
+#endif//__PROPERTIES_COMMAND_LINE__H__
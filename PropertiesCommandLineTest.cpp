@@ -0,0 +1,114 @@
+/**
+ * @file PropertiesCommandLineTest.cpp
+ * @brief Tests of PropertiesCommandLine: classification of the arguments, and loads that match the text based
+ *        load(int, char**, const char*).
+ */
+
+#include "Properties.h"
+#include "PropertiesCommandLine.h"
+
+#include <stdio.h>
+
+#include <sstream>
+#include <string>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+char g_program[] = "program";
+char g_top[] = "top=1";
+char g_first[] = "first:";
+char g_width[] = "width=800";
+char g_bad[] = "bad";
+char g_second[] = "[second]:";
+char g_empty[] = "empty=";
+char g_firstAgain[] = "first:";
+char g_equation[] = "expr=a=b";
+char g_noKey[] = "=value";
+char* g_argv[] = { g_program, g_top, g_first, g_width, g_bad, g_second, g_empty, g_firstAgain, g_equation, g_noKey };
+const int g_argc = sizeof(g_argv) / sizeof(g_argv[0]);
+
+struct CommandLineProperties : public Properties {
+  explicit CommandLineProperties(const char* section)
+      : Properties(section)
+      , width(this, 640, "width", "the image width", Property::DEFAULT_FLAGS) {}
+  ProperT<int> width;
+};
+
+void testClassification() {
+  PropertiesCommandLine commandLine(g_argc, g_argv, IGNORE_ON_BAD_SYNTAX);
+  CHECK(commandLine.sections().size() == 3);
+  CHECK(commandLine.arguments().size() == 4);
+  CHECK(commandLine.badSyntax().size() == 2);
+  if (commandLine.badSyntax().size() == 2) {
+    CHECK(commandLine.badSyntax()[0] == 4);
+    CHECK(commandLine.badSyntax()[1] == 9);
+  }
+
+  // the properties before the first header belong to the unnamed section
+  const PropertiesCommandLine::Section* top = commandLine.find("");
+  CHECK(top != nullptr && top->arguments.size() == 1 && top->arguments[0].key == "top");
+
+  // a repeated section collects all its properties, in command line order
+  const PropertiesCommandLine::Section* first = commandLine.find("first");
+  CHECK(first != nullptr);
+  CHECK(first == commandLine.find("[first]"));
+  if (first && first->arguments.size() == 2) {
+    CHECK(first->arguments[0].key == "width");
+    CHECK(first->arguments[0].value == "800");
+    CHECK(first->arguments[0].position == 3);
+    CHECK(first->arguments[1].key == "expr");
+    CHECK(first->arguments[1].value == "a=b");
+  } else {
+    CHECK(false);
+  }
+
+  const PropertiesCommandLine::Section* second = commandLine.find("second");
+  CHECK(second != nullptr && second == commandLine.find("[second]"));
+  CHECK(second && second->arguments.size() == 1 && second->arguments[0].value.empty());
+  CHECK(commandLine.find("missing") == nullptr);
+}
+
+std::string stored(const Properties& properties) {
+  std::ostringstream out;
+  properties.store(out, Properties::STORE_FREE_PARAMS, '=');
+  return out.str();
+}
+
+void testSameAsTextLoad() {
+  PropertiesCommandLine commandLine(g_argc, g_argv, IGNORE_ON_BAD_SYNTAX);
+  const char* const sections[] = { "first", "second", "missing" };
+  for (size_t s = 0; s < sizeof(sections) / sizeof(sections[0]); ++s) {
+    CommandLineProperties indexed(sections[s]);
+    CommandLineProperties text(sections[s]);
+    CHECK(indexed.load(commandLine, sections[s]) == text.load(g_argc, g_argv, sections[s]));
+    CHECK(indexed.getLastLoadCallSectionFound() == text.getLastLoadCallSectionFound());
+    CHECK(stored(indexed) == stored(text));
+  }
+
+  CommandLineProperties first("first");
+  CHECK(first.load(commandLine, "[first]"));
+  CHECK(first.getProperty(MEtl::string("width"), 0) == 800);
+  CHECK(first.getProperty(MEtl::string("expr"), MEtl::string()) == MEtl::string("a=b"));
+  CHECK(first.loaded());
+}
+}// namespace
+
+int main() {
+  testClassification();
+  testSameAsTextLoad();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
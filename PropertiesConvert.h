@@ -0,0 +1,81 @@
+/**
+ * @file PropertiesConvert.h
+ * @brief Conversion of property values to and from their string representation.
+ */
+
+#ifndef __PROPERTIES_CONVERT__H__
+#define __PROPERTIES_CONVERT__H__
+
+#include "basicTypes/MEtl/string.h"
+
+#include <charconv>
+#include <system_error>
+
+#include "ProperTypes.h"
+
+/**
+ * @struct PropertyConvert
+ * @brief Converts values of type T to and from strings; used by setProperty(), getProperty() and ProperT::sync().
+ *
+ * The generic version uses ttoa() and atot(). Integer types are specialized below with std::to_chars/std::from_chars,
+ * which are locale-free and do not allocate beyond the resulting string. Floating point types keep ttoa() and atot():
+ * their text is part of stored files and checksums, and the shortest round-trip form std::to_chars writes differs from
+ * ttoa()'s. Other types may be specialized the same way.
+ */
+template<typename T>
+struct PropertyConvert {
+  static MEtl::string toString(const T& val) { return ttoa(val); }
+  static T& fromString(T& val, const MEtl::string& str) { return atot(val, str); }
+};
+
+/**
+ * @struct PropertyCharsConvert
+ * @brief std::to_chars/std::from_chars based PropertyConvert of integer types.
+ *
+ * Only plain decimal text that is consumed entirely is parsed here. Anything else (leading blanks or '+', hex, trailing
+ * text, out of range values) is handed to atot(), so such input keeps its former meaning.
+ */
+template<typename T>
+struct PropertyCharsConvert {
+  static MEtl::string toString(const T& val) {
+    char buf[64];
+    std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), val);
+    if (result.ec != std::errc()) {
+      return ttoa(val);
+    }
+    return MEtl::string(buf, result.ptr - buf);
+  }
+
+  static T& fromString(T& val, const MEtl::string& str) {
+    const char* first = str.data();
+    const char* last = first + str.size();
+    T parsed;
+    std::from_chars_result result = std::from_chars(first, last, parsed);
+    if (result.ec != std::errc() || result.ptr != last || first == last) {
+      return atot(val, str);
+    }
+    val = parsed;
+    return val;
+  }
+};
+
+// the types GetDefaultValidator() covers. Character types are left to ttoa()/atot(): their text may be a character
+// rather than a number.
+template<>
+struct PropertyConvert<short> : PropertyCharsConvert<short> {};
+template<>
+struct PropertyConvert<unsigned short> : PropertyCharsConvert<unsigned short> {};
+template<>
+struct PropertyConvert<int> : PropertyCharsConvert<int> {};
+template<>
+struct PropertyConvert<unsigned int> : PropertyCharsConvert<unsigned int> {};
+template<>
+struct PropertyConvert<long> : PropertyCharsConvert<long> {};
+template<>
+struct PropertyConvert<unsigned long> : PropertyCharsConvert<unsigned long> {};
+template<>
+struct PropertyConvert<long long> : PropertyCharsConvert<long long> {};
+template<>
+struct PropertyConvert<unsigned long long> : PropertyCharsConvert<unsigned long long> {};
+
+#endif//__PROPERTIES_CONVERT__H__
@@ -0,0 +1,43 @@
+/**
+ * @file PropertiesConvertBenchmark.cpp
+ * @brief Micro-benchmark of the integer conversions: PropertyConvert (std::to_chars/std::from_chars) against
+ *        ttoa()/atot().
+ *
+ * Usage: PropertiesConvertBenchmark [iterations] (default: 1000000)
+ */
+
+#include "PropertiesBenchmark.h"
+#include "PropertiesConvert.h"
+
+using namespace PropertiesBenchmark;
+
+namespace {
+template<typename T>
+void benchmarkConvert(const char* name, size_t iterations) {
+  const T base = static_cast<T>(1234567);
+  double ttoaOps = opsPerSecond(iterations, [&](size_t i) { g_sink += ttoa(static_cast<T>(base + i)).size(); });
+  double toChars = opsPerSecond(iterations, [&](size_t i) {
+    g_sink += PropertyConvert<T>::toString(static_cast<T>(base + i)).size();
+  });
+  report(name, "ttoa()", ttoaOps);
+  report("", "PropertyConvert::toString()", toChars, ttoaOps);
+
+  const MEtl::string text = ttoa(base);
+  T val = T();
+  double atotOps = opsPerSecond(iterations, [&](size_t) { g_sink += static_cast<long long>(atot(val, text)); });
+  double fromChars = opsPerSecond(iterations, [&](size_t) {
+    g_sink += static_cast<long long>(PropertyConvert<T>::fromString(val, text));
+  });
+  report("", "atot()", atotOps);
+  report("", "PropertyConvert::fromString()", fromChars, atotOps);
+}
+}// namespace
+
+int main(int argc, char* argv[]) {
+  size_t count = iterations(argc, argv);
+  benchmarkConvert<int>("convert int", count);
+  benchmarkConvert<unsigned int>("convert unsigned int", count);
+  benchmarkConvert<long long>("convert long long", count);
+  benchmarkConvert<unsigned long long>("convert unsigned long long", count);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file PropertiesEnvironment.cpp
+ */
+
+#include "PropertiesEnvironment.h"
+#include "Properties.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <mutex>
+
+extern char** environ;
+
+namespace {
+std::mutex g_processMutex;
+std::shared_ptr<const PropertiesEnvironment> g_process;
+
+bool nameLess(const PropertiesEnvironment::Variable& a, const PropertiesEnvironment::Variable& b) {
+  return a.name < b.name;
+}
+}// namespace
+
+PropertiesEnvironment::PropertiesEnvironment(char** env) {
+  size_t count = 0;
+  size_t size = 0;
+  for (char** it = env; it && *it; ++it, ++count) {
+    size += strlen(*it);
+  }
+  // a single buffer, so the views stay valid while the variables are added
+  _buffer.reserve(size);
+  _variables.reserve(count);
+  for (char** it = env; it && *it; ++it) {
+    std::string_view entry(*it);
+    size_t eq = entry.find('=');
+    if (eq == std::string_view::npos || eq == 0) {
+      continue;
+    }
+    size_t offset = _buffer.size();
+    _buffer.append(entry.data(), entry.size());
+    Variable variable;
+    variable.name = std::string_view(_buffer.data() + offset, eq);
+    variable.value = std::string_view(_buffer.data() + offset + eq + 1, entry.size() - eq - 1);
+    _variables.push_back(variable);
+  }
+  std::stable_sort(_variables.begin(), _variables.end(), nameLess);
+}
+
+size_t PropertiesEnvironment::find(std::string_view prefix, const Variable*& first, const Variable*& last) const {
+  Variable key;
+  key.name = prefix;
+  auto begin = std::lower_bound(_variables.begin(), _variables.end(), key, nameLess);
+  auto end = begin;
+  while (end != _variables.end() && end->name.substr(0, prefix.size()) == prefix) {
+    ++end;
+  }
+  first = _variables.data() + (begin - _variables.begin());
+  last = _variables.data() + (end - _variables.begin());
+  return static_cast<size_t>(last - first);
+}
+
+std::shared_ptr<const PropertiesEnvironment> PropertiesEnvironment::process() {
+  std::lock_guard<std::mutex> lock(g_processMutex);
+  if (!g_process) {
+    g_process = std::make_shared<const PropertiesEnvironment>(environ);
+  }
+  return g_process;
+}
+
+void PropertiesEnvironment::refresh() {
+  std::shared_ptr<const PropertiesEnvironment> rebuilt = std::make_shared<const PropertiesEnvironment>(environ);
+  std::lock_guard<std::mutex> lock(g_processMutex);
+  g_process.swap(rebuilt);
+}
+
+bool Properties::load(const PropertiesEnvironment& environment, std::string_view prefix) {
+  const PropertiesEnvironment::Variable* first;
+  const PropertiesEnvironment::Variable* last;
+  _sectionFound = environment.find(prefix, first, last) != 0;
+  bool ok = true;
+  std::vector<std::pair<MEtl::string, MEtl::string>> unknownFields;
+  for (const PropertiesEnvironment::Variable* it = first; it != last; ++it) {
+    std::string_view key = it->name.substr(prefix.size());
+    if (key.empty()) {
+      continue;
+    }
+    if (!_loadRecord(key, MEtl::string(it->value.data(), it->value.size()), Property::FROM_ENV, unknownFields)) {
+      ok = false;
+    }
+  }
+  _loadFinished(Property::FROM_ENV, unknownFields);
+  return ok;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file PropertiesEnvironment.h
+ */
+
+#ifndef __PROPERTIES_ENVIRONMENT__H__
+#define __PROPERTIES_ENVIRONMENT__H__
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class PropertiesEnvironment
+ * @brief A build-once index of environment variables, sorted by name.
+ *
+ * The variables of a section share a name prefix, so they form one contiguous range of the sorted index; finding them
+ * is a binary search instead of a scan of the whole environment (@see Properties::load(const PropertiesEnvironment&,
+ * std::string_view)).
+ *
+ * The index copies the environment on construction and is immutable afterwards, so it can be shared between threads
+ * and is not affected by later setenv()/unsetenv() calls. process() returns the index of the process environment,
+ * built on first use; refresh() rebuilds it, for tests that modify the environment.
+ */
+class PropertiesEnvironment {
+public:
+  struct Variable {
+    std::string_view name;
+    std::string_view value;
+  };
+
+  /**
+   * @brief Index an environment.
+   *
+   * @param[in] env The "name=value" strings, terminated by a null pointer (as environ); entries without '=' are
+   *                ignored.
+   */
+  explicit PropertiesEnvironment(char** env);
+
+  /**
+   * @brief Get the variables whose names start with a prefix.
+   *
+   * @param[in] prefix The name prefix.
+   * @param[out] first The first matching variable.
+   * @param[out] last One past the last matching variable.
+   * @return The number of matching variables.
+   */
+  size_t find(std::string_view prefix, const Variable*& first, const Variable*& last) const;
+
+  /// @brief Get all variables, sorted by name.
+  const std::vector<Variable>& variables() const { return _variables; }
+
+  /// @brief Get the index of the process environment, built on first use.
+  static std::shared_ptr<const PropertiesEnvironment> process();
+
+  /// @brief Rebuild the index of the process environment; indexes returned by process() before stay valid.
+  static void refresh();
+
+private:
+  PropertiesEnvironment(const PropertiesEnvironment& other);
+  PropertiesEnvironment& operator=(const PropertiesEnvironment& other);
+
+  std::string _buffer; /** < The copied "name=value" strings, the variables refer to it.*/
+  std::vector<Variable> _variables;
+};
+
+#endif//__PROPERTIES_ENVIRONMENT__H__
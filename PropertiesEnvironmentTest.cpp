@@ -0,0 +1,121 @@
+/**
+ * @file PropertiesEnvironmentTest.cpp
+ * @brief Tests of PropertiesEnvironment: the prefix ranges of the sorted index, the process index, and loads by prefix.
+ */
+
+#include "Properties.h"
+#include "PropertiesEnvironment.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+char g_path[] = "PATH=/bin";
+char g_width[] = "CAM_width=800";
+char g_mode[] = "CAM_mode=night=on";
+char g_prefixOnly[] = "CAM_=ignored";
+char g_other[] = "CAMERA=1";
+char g_noValue[] = "NO_EQUALS";
+char g_noName[] = "=anonymous";
+char g_empty[] = "CAM_empty=";
+char* g_env[] = { g_path, g_width, g_mode, g_prefixOnly, g_other, g_noValue, g_noName, g_empty, nullptr };
+
+struct EnvironmentProperties : public Properties {
+  EnvironmentProperties()
+      : Properties("camera")
+      , width(this, 640, "width", "the image width", Property::DEFAULT_FLAGS) {}
+  ProperT<int> width;
+};
+
+void testIndex() {
+  PropertiesEnvironment environment(g_env);
+  // entries without a name or without '=' are ignored
+  CHECK(environment.variables().size() == 6);
+  for (size_t i = 1; i < environment.variables().size(); ++i) {
+    CHECK(environment.variables()[i - 1].name <= environment.variables()[i].name);
+  }
+
+  const PropertiesEnvironment::Variable* first;
+  const PropertiesEnvironment::Variable* last;
+  CHECK(environment.find("CAM_", first, last) == 4);
+  for (const PropertiesEnvironment::Variable* it = first; it != last; ++it) {
+    CHECK(it->name.substr(0, 4) == "CAM_");
+  }
+  CHECK(environment.find("CAM", first, last) == 5);
+  CHECK(environment.find("", first, last) == 6);
+  CHECK(environment.find("ZZZ", first, last) == 0);
+  CHECK(first == last);
+
+  // the index copies the environment
+  g_width[10] = '9';
+  CHECK(environment.find("CAM_width", first, last) == 1);
+  CHECK(first->value == "800");
+  g_width[10] = '8';
+}
+
+void testProcess() {
+  setenv("PROPERTIES_ENVIRONMENT_TEST_KEY", "before", 1);
+  PropertiesEnvironment::refresh();
+  std::shared_ptr<const PropertiesEnvironment> before = PropertiesEnvironment::process();
+  CHECK(before == PropertiesEnvironment::process());
+  setenv("PROPERTIES_ENVIRONMENT_TEST_KEY", "after", 1);
+  // the index is not affected by setenv() until it is refreshed, and older indexes stay valid
+  const PropertiesEnvironment::Variable* first;
+  const PropertiesEnvironment::Variable* last;
+  CHECK(PropertiesEnvironment::process()->find("PROPERTIES_ENVIRONMENT_TEST_KEY", first, last) == 1);
+  CHECK(first->value == "before");
+  PropertiesEnvironment::refresh();
+  CHECK(PropertiesEnvironment::process()->find("PROPERTIES_ENVIRONMENT_TEST_KEY", first, last) == 1);
+  CHECK(first->value == "after");
+  CHECK(before->find("PROPERTIES_ENVIRONMENT_TEST_KEY", first, last) == 1);
+  CHECK(first->value == "before");
+  unsetenv("PROPERTIES_ENVIRONMENT_TEST_KEY");
+  PropertiesEnvironment::refresh();
+}
+
+void testLoad() {
+  PropertiesEnvironment environment(g_env);
+  EnvironmentProperties properties;
+  CHECK(properties.load(environment, "CAM_"));
+  CHECK(properties.getLastLoadCallSectionFound());
+  CHECK(properties.getProperty(MEtl::string("width"), 0) == 800);
+  CHECK(properties.getProperty(MEtl::string("mode"), MEtl::string()) == MEtl::string("night=on"));
+  bool exist = false;
+  CHECK(properties.getProperty(MEtl::string("empty"), MEtl::string("x"), &exist) == MEtl::string());
+  CHECK(exist);
+  // the variable named exactly as the prefix has no key
+  CHECK(properties.properties().count(MEtl::string("")) == 0);
+  CHECK(properties.properties().count(MEtl::string("ERA")) == 0);
+
+  EnvironmentProperties missing;
+  CHECK(missing.load(environment, "NONE_"));
+  CHECK(!missing.getLastLoadCallSectionFound());
+  CHECK(missing.getProperty(MEtl::string("width"), 0) == 640);
+}
+}// namespace
+
+int main() {
+  testIndex();
+  testProcess();
+  testLoad();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * @file PropertiesIndex.cpp
+ */
+
+#include "PropertiesIndex.h"
+#include "Properties.h"
+#include "PropertiesChecksum.h"
+
+namespace {
+const size_t INITIAL_BUCKETS = 16;
+}
+
+PropertiesIndex::PropertiesIndex()
+    : _buckets(INITIAL_BUCKETS)
+    , _mask(INITIAL_BUCKETS - 1)
+    , _valueCount(0)
+    , _modifiedCount(0)
+    , _propertyCount(0)
+    , _checksum(0) {}
+
+PropertiesIndex::PropertiesIndex(const PropertiesIndex& other)
+    : _entries(other._entries)
+    , _buckets(other._buckets)
+    , _changed(other._changed)
+    , _mask(other._mask)
+    , _valueCount(other._valueCount)
+    , _modifiedCount(other._modifiedCount)
+    , _propertyCount(other._propertyCount)
+    , _checksum(other._checksum) {
+  copyKeys();
+}
+
+PropertiesIndex& PropertiesIndex::operator=(const PropertiesIndex& other) {
+  if (this != &other) {
+    _entries = other._entries;
+    _buckets = other._buckets;
+    _changed = other._changed;
+    _mask = other._mask;
+    _valueCount = other._valueCount;
+    _modifiedCount = other._modifiedCount;
+    _propertyCount = other._propertyCount;
+    _checksum = other._checksum;
+    copyKeys();
+  }
+  return *this;
+}
+
+// the copied entries still point to the other index's keys; interned keys are shared
+void PropertiesIndex::copyKeys() {
+  _keys.clear();
+  for (size_t i = 0; i < _entries.size(); ++i) {
+    Entry& entry = _entries[i];
+    if (entry.symbol == PropertiesSymbols::NONE) {
+      _keys.push_back(*entry.key);
+      entry.key = &_keys.back();
+    }
+  }
+}
+
+PropertiesIndex::Slot PropertiesIndex::find(const char* key, size_t len, uint64_t keyHash) const {
+  const uint32_t fp = fingerprint(keyHash);
+  for (size_t pos = keyHash & _mask;; pos = (pos + 1) & _mask) {
+    const Bucket& bucket = _buckets[pos];
+    if (bucket.entry == 0) {
+      return NPOS;
+    }
+    if (bucket.fingerprint == fp) {
+      const Entry& entry = _entries[bucket.entry - 1];
+      if (entry.hash == keyHash && entry.key->size() == len && memcmp(entry.key->data(), key, len) == 0) {
+        return bucket.entry - 1;
+      }
+    }
+  }
+}
+
+PropertiesIndex::Slot PropertiesIndex::insert(const char* key, size_t len, uint64_t keyHash) {
+  Slot slot = find(key, len, keyHash);
+  if (slot != NPOS) {
+    return slot;
+  }
+  // keep the load factor at or below 1/2 so probe sequences stay short
+  if ((_entries.size() + 1) * 2 > _buckets.size()) {
+    grow();
+  }
+  slot = static_cast<Slot>(_entries.size());
+  Entry entry;
+  _keys.push_back(MEtl::string());
+  _keys.back().assign(key, len);
+  entry.key = &_keys.back();
+  entry.symbol = PropertiesSymbols::NONE;
+  entry.property = nullptr;
+  entry.hash = keyHash;
+  entry.loaded = 0;
+  entry.unformatted = 0;
+  entry.flags = 0;
+  _entries.push_back(entry);
+
+  size_t pos = keyHash & _mask;
+  while (_buckets[pos].entry != 0) {
+    pos = (pos + 1) & _mask;
+  }
+  _buckets[pos].fingerprint = fingerprint(keyHash);
+  _buckets[pos].entry = slot + 1;
+  return slot;
+}
+
+void PropertiesIndex::grow() {
+  std::vector<Bucket> buckets(_buckets.size() * 2);
+  size_t mask = buckets.size() - 1;
+  for (size_t i = 0; i < _buckets.size(); ++i) {
+    if (_buckets[i].entry == 0) {
+      continue;
+    }
+    size_t pos = _entries[_buckets[i].entry - 1].hash & mask;
+    while (buckets[pos].entry != 0) {
+      pos = (pos + 1) & mask;
+    }
+    buckets[pos] = _buckets[i];
+  }
+  _buckets.swap(buckets);
+  _mask = mask;
+}
+
+void PropertiesIndex::setValue(Slot slot, const MEtl::string& val, unsigned int loaded, bool markModified) {
+  Entry& entry = _entries[slot];
+  entry.loaded = loaded;
+  if ((entry.flags & HAS_VALUE) && entry.value == val) {
+    return;
+  }
+  _checksum ^= checksumOf(entry);
+  if (markModified && !(entry.flags & IS_MODIFIED)) {
+    entry.original = entry.value;
+    entry.flags |= IS_MODIFIED;
+    ++_modifiedCount;
+  }
+  if (!(entry.flags & HAS_VALUE)) {
+    entry.flags |= HAS_VALUE;
+    ++_valueCount;
+  }
+  entry.value = val;
+  _checksum ^= checksumOf(entry);
+  entry.flags &= ~IS_SYNCED;
+  if (!(entry.flags & IS_CHANGED)) {
+    entry.flags |= IS_CHANGED;
+    _changed.push_back(slot);
+  }
+}
+
+void PropertiesIndex::takeChanged(std::vector<Slot>& slots) {
+  slots.clear();
+  slots.swap(_changed);
+  for (size_t i = 0; i < slots.size(); ++i) {
+    _entries[slots[i]].flags &= ~IS_CHANGED;
+  }
+}
+
+void PropertiesIndex::setProperty(Slot slot, const Property* property) {
+  if (!property) {
+    removeProperty(slot);
+    return;
+  }
+  Entry& entry = _entries[slot];
+  if (entry.symbol == PropertiesSymbols::NONE) {
+    // the stored key stays in _keys, references handed out for it remain valid
+    entry.symbol = PropertiesSymbols::intern(entry.key->data(), entry.key->size(), entry.hash);
+    entry.key = &PropertiesSymbols::name(entry.symbol);
+  }
+  _checksum ^= checksumOf(entry);
+  if (!(entry.flags & HAS_PROPERTY)) {
+    entry.flags |= HAS_PROPERTY;
+    ++_propertyCount;
+  }
+  entry.property = property;
+  _checksum ^= checksumOf(entry);
+  entry.flags &= ~IS_SYNCED;
+}
+
+void PropertiesIndex::removeProperty(Slot slot) {
+  Entry& entry = _entries[slot];
+  if (!(entry.flags & HAS_PROPERTY)) {
+    return;
+  }
+  _checksum ^= checksumOf(entry);
+  entry.flags &= ~(HAS_PROPERTY | IS_SYNCED);
+  entry.property = nullptr;
+  --_propertyCount;
+}
+
+void PropertiesIndex::setUnformatted(Slot slot, int unformatted) {
+  Entry& entry = _entries[slot];
+  entry.flags |= HAS_UNFORMATTED;
+  entry.unformatted = unformatted;
+}
+
+void PropertiesIndex::eraseValue(Slot slot) {
+  Entry& entry = _entries[slot];
+  _checksum ^= checksumOf(entry);
+  if (entry.flags & IS_MODIFIED) {
+    --_modifiedCount;
+  }
+  if (entry.flags & HAS_VALUE) {
+    --_valueCount;
+  }
+  if (entry.flags & HAS_VALUE && !(entry.flags & IS_CHANGED)) {
+    entry.flags |= IS_CHANGED;
+    _changed.push_back(slot);
+  }
+  entry.flags &= ~(HAS_VALUE | IS_MODIFIED | IS_SYNCED);
+  entry.value.clear();
+  entry.original.clear();
+  entry.loaded = 0;
+}
+
+void PropertiesIndex::eraseUnformatted(Slot slot) {
+  _entries[slot].flags &= ~HAS_UNFORMATTED;
+}
+
+void PropertiesIndex::clearModified() {
+  for (size_t i = 0; i < _entries.size(); ++i) {
+    _entries[i].flags &= ~IS_MODIFIED;
+    _entries[i].original.clear();
+  }
+  _modifiedCount = 0;
+}
+
+void PropertiesIndex::clearValues() {
+  for (size_t i = 0; i < _entries.size(); ++i) {
+    Entry& entry = _entries[i];
+    entry.value.clear();
+    entry.original.clear();
+    entry.property = nullptr;
+    entry.loaded = 0;
+    entry.unformatted = 0;
+    entry.flags = 0;
+  }
+  _changed.clear();
+  _checksum = 0;
+  _valueCount = 0;
+  _modifiedCount = 0;
+  _propertyCount = 0;
+}
+
+uint32_t PropertiesIndex::checksumOf(const Entry& entry) {
+  if ((entry.flags & (HAS_VALUE | HAS_PROPERTY)) != (HAS_VALUE | HAS_PROPERTY) || !entry.property ||
+      !(entry.property->flags & Property::CHECKSUM)) {
+    return 0;
+  }
+  return Properties_EntryChecksum(*entry.key, entry.value);
+}
+
+size_t PropertiesIndex::count(unsigned int flag) const {
+  switch (flag) {
+    case HAS_VALUE:
+      return _valueCount;
+    case IS_MODIFIED:
+      return _modifiedCount;
+    case HAS_PROPERTY:
+      return _propertyCount;
+    default:
+      break;
+  }
+  size_t n = 0;
+  for (size_t i = 0; i < _entries.size(); ++i) {
+    if (_entries[i].flags & flag) {
+      ++n;
+    }
+  }
+  return n;
+}
@@ -0,0 +1,302 @@
+/**
+ * @file PropertiesIndex.h
+ */
+
+#ifndef __PROPERTIES_INDEX__H__
+#define __PROPERTIES_INDEX__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "PropertiesSymbols.h"
+
+class Property;
+
+/**
+ * @class PropertiesIndex
+ * @brief Open-addressing key index holding everything a Properties object knows about a key.
+ *
+ * A single hash lookup resolves a key to a slot. The slot holds the string value, the registered Property (if any),
+ * the loaded-source bits, the unformatted marker and the modified flag together with the value it had before it was
+ * first modified. This replaces the former parallel maps (_map, _unformatted, _metaData and _modified).
+ *
+ * Slots are stored densely in insertion order and are never removed or moved, so a Slot stays valid for the lifetime
+ * of the index. Removing a key only clears the slot's flags; re-adding the key reuses the same slot.
+ *
+ * Each index stores the keys inserted into it, at addresses that stay valid as long as the index lives. The names of
+ * registered properties are interned instead (see PropertiesSymbols), so every index and every copy of it refers to
+ * the single stored copy of such a key. Keys of free parameters are never added to the process wide table. find()
+ * compares the characters of a key once its bucket fingerprint and full hash matched, whether it is interned or not.
+ */
+class PropertiesIndex {
+public:
+  typedef uint32_t Slot;
+  static const Slot NPOS = 0xFFFFFFFFu;
+
+  /// @brief Enumerates what a slot currently holds.
+  enum EntryFlags {
+    HAS_VALUE = 1 << 0,       /** < value is set (the key appears in properties())*/
+    HAS_PROPERTY = 1 << 1,    /** < a Property object is registered for this key*/
+    HAS_UNFORMATTED = 1 << 2, /** < unformatted is set*/
+    IS_MODIFIED = 1 << 3,     /** < value was modified, original holds the value before modification*/
+    IS_SYNCED = 1 << 4,       /** < the registered property's binary value was synced from the current value*/
+    IS_CHANGED = 1 << 5       /** < the value text changed since the last takeChanged()*/
+  };
+
+  struct Entry {
+    const MEtl::string* key;      /** < The key, as given on insertion.*/
+    PropertiesSymbols::Id symbol; /** < The symbol id of an interned key, NONE if the index stores the key.*/
+    MEtl::string value;           /** < The current string value of the key.*/
+    MEtl::string original;        /** < The value before the first modification (valid if IS_MODIFIED).*/
+    const Property* property;     /** < The registered property (valid if HAS_PROPERTY).*/
+    uint64_t hash;                /** < The full hash of the key.*/
+    unsigned int loaded;          /** < Property::Loaded bits of the current value.*/
+    int unformatted;              /** < Unformatted marker (valid if HAS_UNFORMATTED).*/
+    unsigned int flags;           /** < EntryFlags.*/
+  };
+
+  /**
+   * @brief Hash a key (FNV-1a, 64 bit).
+   *
+   * The function is constexpr so that keys known at compile time can be hashed by the compiler.
+   *
+   * @param[in] str The key characters.
+   * @param[in] len The number of characters in the key.
+   * @return The hash of the key.
+   */
+  static constexpr uint64_t hash(const char* str, size_t len) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < len; ++i) {
+      h = (h ^ static_cast<unsigned char>(str[i])) * 1099511628211ull;
+    }
+    return h;
+  }
+
+  PropertiesIndex();
+  PropertiesIndex(const PropertiesIndex& other);
+  PropertiesIndex& operator=(const PropertiesIndex& other);
+
+  /**
+   * @brief Find the slot of a key.
+   *
+   * @param[in] key The key to look for.
+   * @return The slot of the key, or NPOS if the key was never inserted.
+   */
+  Slot find(const MEtl::string& key) const { return find(key.c_str(), key.size()); }
+  Slot find(const char* key) const { return find(key, strlen(key)); }
+  Slot find(const char* key, size_t len) const { return find(key, len, hash(key, len)); }
+  Slot find(const char* key, size_t len, uint64_t keyHash) const;
+
+  /**
+   * @brief Find the slot of a key, creating an empty slot (no flags set) if the key is not indexed yet.
+   *
+   * @param[in] key The key to look for.
+   * @return The slot of the key.
+   */
+  Slot insert(const MEtl::string& key) { return insert(key.c_str(), key.size(), hash(key.c_str(), key.size())); }
+  Slot insert(const char* key, size_t len, uint64_t keyHash);
+
+  Entry& at(Slot slot) { return _entries[slot]; }
+  const Entry& at(Slot slot) const { return _entries[slot]; }
+
+  /**
+   * @brief Get the value of a key as a C-style string.
+   *
+   * @param[in] slot The slot of the key (NPOS is allowed).
+   * @return The value of the key, or nullptr if the slot holds no value.
+   */
+  const char* value(Slot slot) const {
+    if (slot == NPOS || !(_entries[slot].flags & HAS_VALUE)) {
+      return nullptr;
+    }
+    return _entries[slot].value.c_str();
+  }
+
+  /**
+   * @brief Set the value of a slot, keeping the value/modified counters up to date.
+   *
+   * If markModified is true and the slot was not modified yet, its previous value is kept as the original value.
+   * If the text of the value changes, the slot is recorded as changed (see takeChanged()) and loses its synced
+   * state; setting the same text again keeps both.
+   *
+   * @param[in] slot The slot to update.
+   * @param[in] val The new value.
+   * @param[in] loaded The Property::Loaded bits of the new value.
+   * @param[in] markModified Whether the change should be tracked as a modification.
+   */
+  void setValue(Slot slot, const MEtl::string& val, unsigned int loaded, bool markModified);
+
+  /**
+   * @brief Get the property registered for a slot.
+   *
+   * @param[in] slot The slot of the key (NPOS is allowed).
+   * @return The registered property, or nullptr if none is registered.
+   */
+  const Property* property(Slot slot) const {
+    if (slot == NPOS || !(_entries[slot].flags & HAS_PROPERTY)) {
+      return nullptr;
+    }
+    return _entries[slot].property;
+  }
+
+  /**
+   * @brief Check whether the registered property's binary value reflects the current string value of a slot.
+   *
+   * setValue() clears this state, markSynced() sets it once the property was synced from the current value.
+   */
+  bool isSynced(Slot slot) const { return (_entries[slot].flags & IS_SYNCED) != 0; }
+  void markSynced(Slot slot) { _entries[slot].flags |= IS_SYNCED; }
+
+  /**
+   * @brief Get the slots whose value text changed since the previous call, and reset their changed state.
+   *
+   * @param[out] slots Receives the changed slots, in the order they first changed.
+   */
+  void takeChanged(std::vector<Slot>& slots);
+
+  /// @brief Register a property for a slot and intern its key; nullptr is the same as removeProperty().
+  void setProperty(Slot slot, const Property* property);
+
+  /// @brief Unregister the property of a slot, e.g. when the property is destroyed. The value of the slot is kept.
+  void removeProperty(Slot slot);
+  void setUnformatted(Slot slot, int unformatted);
+
+  /// @brief Clear the value (and modification) of a slot. The slot itself stays valid.
+  void eraseValue(Slot slot);
+  void eraseUnformatted(Slot slot);
+
+  /// @brief Clear the modified flag of all slots.
+  void clearModified();
+
+  /// @brief Clear all values, properties and flags. Slots stay valid.
+  void clearValues();
+
+  /**
+   * @brief Get the XOR of the Properties_EntryChecksum() contributions of the values of CHECKSUM flagged properties.
+   *
+   * The checksum is kept up to date by every change of a value or property, so this is O(1).
+   */
+  uint32_t checksum() const { return _checksum; }
+
+  size_t slots() const { return _entries.size(); }
+  size_t values() const { return _valueCount; }
+  size_t modifiedValues() const { return _modifiedCount; }
+
+  /**
+   * @class View
+   * @brief A read-only, map-like view over the slots having a given flag.
+   *
+   * Iteration is in insertion order. Dereferencing an iterator yields a pair of references (key, member), so
+   * existing code written against std::map (it->first, it->second) keeps working.
+   */
+  template<unsigned int FLAG, typename V, V Entry::*MEMBER>
+  class View {
+  public:
+    typedef std::pair<const MEtl::string&, const V&> value_type;
+
+    class const_iterator {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef typename View::value_type value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef value_type reference;
+
+      struct Arrow {
+        value_type _pair;
+        const value_type* operator->() const { return &_pair; }
+      };
+
+      const_iterator(const Entry* it, const Entry* end)
+          : _it(it)
+          , _end(end) {
+        skip();
+      }
+      value_type operator*() const { return value_type(*_it->key, (*_it).*MEMBER); }
+      Arrow operator->() const { return Arrow{ **this }; }
+      const_iterator& operator++() {
+        ++_it;
+        skip();
+        return *this;
+      }
+      const_iterator operator++(int) {
+        const_iterator tmp(*this);
+        ++*this;
+        return tmp;
+      }
+      bool operator==(const const_iterator& other) const { return _it == other._it; }
+      bool operator!=(const const_iterator& other) const { return _it != other._it; }
+
+    private:
+      void skip() {
+        while (_it != _end && !(_it->flags & FLAG)) {
+          ++_it;
+        }
+      }
+      const Entry* _it;
+      const Entry* _end;
+    };
+    typedef const_iterator iterator;
+
+    explicit View(const PropertiesIndex& index)
+        : _index(index) {}
+
+    const_iterator begin() const { return const_iterator(first(), last()); }
+    const_iterator end() const { return const_iterator(last(), last()); }
+    const_iterator find(const MEtl::string& key) const {
+      Slot slot = _index.find(key);
+      if (slot == NPOS || !(_index.at(slot).flags & FLAG)) {
+        return end();
+      }
+      return const_iterator(first() + slot, last());
+    }
+    size_t count(const MEtl::string& key) const { return find(key) == end() ? 0 : 1; }
+    size_t size() const { return _index.count(FLAG); }
+    bool empty() const { return size() == 0; }
+
+  private:
+    const Entry* first() const { return _index._entries.data(); }
+    const Entry* last() const { return _index._entries.data() + _index._entries.size(); }
+    const PropertiesIndex& _index;
+  };
+
+  typedef View<HAS_VALUE, MEtl::string, &Entry::value> ValueView;
+  typedef View<IS_MODIFIED, MEtl::string, &Entry::original> ModifiedView;
+  typedef View<HAS_PROPERTY, const Property*, &Entry::property> PropertyView;
+
+  ValueView valueView() const { return ValueView(*this); }
+  ModifiedView modifiedView() const { return ModifiedView(*this); }
+  PropertyView propertyView() const { return PropertyView(*this); }
+
+private:
+  /// @brief A hash table bucket: the upper hash bits are compared before the entry itself is touched.
+  struct Bucket {
+    uint32_t fingerprint;
+    uint32_t entry; /** < entry index + 1, 0 marks an empty bucket*/
+  };
+
+  size_t count(unsigned int flag) const;
+  void grow();
+  static uint32_t checksumOf(const Entry& entry);
+  static uint32_t fingerprint(uint64_t keyHash) { return static_cast<uint32_t>(keyHash >> 32); }
+  void copyKeys();
+
+  std::vector<Entry> _entries;  /** < Slots in insertion order.*/
+  std::deque<MEtl::string> _keys; /** < Keys that are not interned; a deque never moves its elements.*/
+  std::vector<Bucket> _buckets; /** < Open-addressing (linear probing) table, size is a power of two.*/
+  std::vector<Slot> _changed;   /** < Slots having IS_CHANGED.*/
+  size_t _mask;
+  size_t _valueCount;
+  size_t _modifiedCount;
+  size_t _propertyCount;
+  uint32_t _checksum;           /** < XOR of checksumOf() of all slots.*/
+};
+
+#endif//__PROPERTIES_INDEX__H__
@@ -0,0 +1,190 @@
+/**
+ * @file PropertiesIndexTest.cpp
+ * @brief Behavior tests of PropertiesIndex: insert, find, grow, erase, copy and the counters.
+ */
+
+#include "PropertiesIndex.h"
+
+#include <stdio.h>
+
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+MEtl::string keyOf(size_t i) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "key%zu", i);
+  return MEtl::string(buf);
+}
+
+void testInsertFind() {
+  PropertiesIndex index;
+  CHECK(index.find("a") == PropertiesIndex::NPOS);
+  PropertiesIndex::Slot a = index.insert(MEtl::string("a"));
+  PropertiesIndex::Slot b = index.insert(MEtl::string("b"));
+  CHECK(a == 0);
+  CHECK(b == 1);
+  CHECK(index.insert(MEtl::string("a")) == a);
+  CHECK(index.find("a") == a);
+  CHECK(index.find(MEtl::string("b")) == b);
+  CHECK(index.find("ab") == PropertiesIndex::NPOS);
+  CHECK(*index.at(a).key == "a");
+  CHECK(index.at(a).flags == 0);
+  CHECK(index.slots() == 2);
+  CHECK(index.values() == 0);
+  CHECK(index.value(a) == nullptr);
+  CHECK(index.value(PropertiesIndex::NPOS) == nullptr);
+  CHECK(index.property(a) == nullptr);
+}
+
+void testGrow() {
+  PropertiesIndex index;
+  const size_t count = 1000;
+  std::vector<PropertiesIndex::Slot> slots;
+  for (size_t i = 0; i < count; ++i) {
+    slots.push_back(index.insert(keyOf(i)));
+    index.setValue(slots.back(), keyOf(i), 0, false);
+  }
+  CHECK(index.slots() == count);
+  CHECK(index.values() == count);
+  for (size_t i = 0; i < count; ++i) {
+    // slots are dense and stay where they were inserted while the table grows
+    CHECK(slots[i] == i);
+    CHECK(index.find(keyOf(i)) == slots[i]);
+    CHECK(index.at(slots[i]).value == keyOf(i));
+  }
+  CHECK(index.find(keyOf(count)) == PropertiesIndex::NPOS);
+  size_t visited = 0;
+  PropertiesIndex::ValueView values = index.valueView();
+  for (PropertiesIndex::ValueView::const_iterator it = values.begin(); it != values.end(); ++it, ++visited) {
+    CHECK(it->first == keyOf(visited));
+  }
+  CHECK(visited == count);
+}
+
+void testValuesAndModifications() {
+  PropertiesIndex index;
+  PropertiesIndex::Slot a = index.insert(MEtl::string("a"));
+  PropertiesIndex::Slot b = index.insert(MEtl::string("b"));
+  index.setValue(a, "1", 1, false);
+  index.setValue(b, "2", 1, false);
+  CHECK(index.values() == 2);
+  CHECK(index.modifiedValues() == 0);
+  CHECK(MEtl::string(index.value(a)) == "1");
+
+  index.setValue(a, "3", 16, true);
+  index.setValue(a, "4", 16, true);
+  CHECK(index.values() == 2);
+  CHECK(index.modifiedValues() == 1);
+  CHECK(index.at(a).original == "1");
+  CHECK(index.modifiedView().count(MEtl::string("a")) == 1);
+  CHECK(index.modifiedView().count(MEtl::string("b")) == 0);
+
+  std::vector<PropertiesIndex::Slot> changed;
+  index.takeChanged(changed);
+  CHECK(changed.size() == 2);
+  CHECK(changed[0] == a && changed[1] == b);
+  index.setValue(b, "2", 1, false);// the same text is not a change
+  index.takeChanged(changed);
+  CHECK(changed.empty());
+
+  index.clearModified();
+  CHECK(index.modifiedValues() == 0);
+  CHECK(index.modifiedView().empty());
+  CHECK(MEtl::string(index.value(a)) == "4");
+}
+
+void testErase() {
+  PropertiesIndex index;
+  PropertiesIndex::Slot a = index.insert(MEtl::string("a"));
+  index.setValue(a, "1", 1, true);
+  index.setUnformatted(a, 7);
+  CHECK(index.values() == 1);
+  CHECK(index.modifiedValues() == 1);
+
+  index.eraseValue(a);
+  CHECK(index.values() == 0);
+  CHECK(index.modifiedValues() == 0);
+  CHECK(index.value(a) == nullptr);
+  CHECK(index.find("a") == a);
+  CHECK(index.at(a).flags & PropertiesIndex::HAS_UNFORMATTED);
+  index.eraseUnformatted(a);
+  CHECK(index.at(a).flags == PropertiesIndex::IS_CHANGED);
+
+  // re-adding the key reuses its slot
+  CHECK(index.insert(MEtl::string("a")) == a);
+  index.setValue(a, "2", 1, false);
+  CHECK(index.values() == 1);
+  index.eraseValue(a);
+  index.eraseValue(a);
+  CHECK(index.values() == 0);
+
+  index.setValue(a, "3", 1, true);
+  index.clearValues();
+  CHECK(index.values() == 0);
+  CHECK(index.modifiedValues() == 0);
+  CHECK(index.slots() == 1);
+  CHECK(index.find("a") == a);
+}
+
+void testProperties() {
+  PropertiesIndex index;
+  PropertiesIndex::Slot a = index.insert(MEtl::string("a"));
+  index.setValue(a, "1", 1, false);
+  // unregistering a slot without a property, or registering nullptr, leaves the slot as it is
+  index.removeProperty(a);
+  index.setProperty(a, nullptr);
+  CHECK(index.property(a) == nullptr);
+  CHECK(index.propertyView().empty());
+  CHECK(MEtl::string(index.value(a)) == "1");
+  CHECK(index.checksum() == 0);
+}
+
+void testCopy() {
+  size_t symbols = PropertiesSymbols::size();
+  PropertiesIndex* index = new PropertiesIndex();
+  for (size_t i = 0; i < 100; ++i) {
+    index->setValue(index->insert(keyOf(i)), keyOf(i), 1, false);
+  }
+  // free parameter keys are stored by the index, not interned
+  CHECK(PropertiesSymbols::size() == symbols);
+  PropertiesIndex copy(*index);
+  PropertiesIndex assigned;
+  assigned = *index;
+  delete index;
+  for (size_t i = 0; i < 100; ++i) {
+    PropertiesIndex::Slot slot = copy.find(keyOf(i));
+    CHECK(slot == i);
+    CHECK(*copy.at(slot).key == keyOf(i));
+    CHECK(assigned.find(keyOf(i)) == i);
+    CHECK(*assigned.at(slot).key == keyOf(i));
+  }
+  CHECK(copy.values() == 100);
+  CHECK(copy.insert(MEtl::string("new")) == 100);
+  CHECK(assigned.find("new") == PropertiesIndex::NPOS);
+}
+}// namespace
+
+int main() {
+  testInsertFind();
+  testGrow();
+  testValuesAndModifications();
+  testErase();
+  testProperties();
+  testCopy();
+  if (g_failures) {
+    fprintf(stderr, "%d checks failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
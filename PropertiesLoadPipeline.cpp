@@ -0,0 +1,250 @@
+/**
+ * @file PropertiesLoadPipeline.cpp
+ */
+
+#include "PropertiesLoadPipeline.h"
+#include "Properties.h"
+#include "PropertiesCommandLine.h"
+#include "PropertiesEnvironment.h"
+#include "PropertiesParallel.h"
+#include "PropertiesSectionIndex.h"
+#include "PropertiesTokenizer.h"
+
+#include <chrono>
+#include <unordered_map>
+
+namespace {
+enum SourceKind { FILE_SOURCE, COMMAND_LINE_SOURCE, ENVIRONMENT_SOURCE };
+
+/// @brief A key and value routed to an object; both point into the source.
+struct Record {
+  std::string_view key;
+  std::string_view value;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}// namespace
+
+struct PropertiesLoadPipeline::Source {
+  SourceKind kind;
+  unsigned int source; /** < The Property::Loaded bit the values are marked with.*/
+  MEtl::string file;
+  char sep;
+  MappedFile mapped;
+  std::vector<IniRecord> records;
+  const PropertiesCommandLine* commandLine;
+  const PropertiesEnvironment* environment;
+  MEtl::string separator;
+  bool ok;
+};
+
+/// @brief The records of one object, per source.
+struct PropertiesLoadPipeline::Target {
+  Properties* properties;
+  std::vector<std::vector<Record>> records;
+  std::vector<char> sectionFound;
+  std::vector<std::vector<std::pair<MEtl::string, MEtl::string>>> unknownFields;
+  bool ok;
+};
+
+PropertiesLoadPipeline::PropertiesLoadPipeline(const std::vector<Properties*>& containers)
+    : _containers(containers) {
+  _timings = Timings();
+}
+
+PropertiesLoadPipeline::~PropertiesLoadPipeline() {}
+
+void PropertiesLoadPipeline::addFile(const MEtl::string& file, char sep, unsigned int source) {
+  std::unique_ptr<Source> added(new Source());
+  added->kind = FILE_SOURCE;
+  added->source = source;
+  added->file = file;
+  added->sep = sep;
+  added->commandLine = nullptr;
+  added->environment = nullptr;
+  added->ok = true;
+  _sources.push_back(std::move(added));
+}
+
+void PropertiesLoadPipeline::addFile(const MEtl::string& file, char sep) {
+  addFile(file, sep, Property::FROM_INF);
+}
+
+void PropertiesLoadPipeline::addCommandLine(const PropertiesCommandLine& commandLine) {
+  std::unique_ptr<Source> added(new Source());
+  added->kind = COMMAND_LINE_SOURCE;
+  added->source = Property::FROM_ARGS;
+  added->sep = '=';
+  added->commandLine = &commandLine;
+  added->environment = nullptr;
+  added->ok = true;
+  _sources.push_back(std::move(added));
+}
+
+void PropertiesLoadPipeline::addEnvironment(const PropertiesEnvironment& environment, const MEtl::string& separator) {
+  std::unique_ptr<Source> added(new Source());
+  added->kind = ENVIRONMENT_SOURCE;
+  added->source = Property::FROM_ENV;
+  added->sep = '=';
+  added->commandLine = nullptr;
+  added->environment = &environment;
+  added->separator = separator;
+  added->ok = true;
+  _sources.push_back(std::move(added));
+}
+
+bool PropertiesLoadPipeline::run(unsigned int threads) {
+  _timings = Timings();
+  _targets.assign(_containers.size(), Target());
+  for (size_t i = 0; i < _targets.size(); ++i) {
+    Target& target = _targets[i];
+    target.properties = _containers[i];
+    target.records.resize(_sources.size());
+    target.sectionFound.assign(_sources.size(), 0);
+    target.unknownFields.resize(_sources.size());
+    target.ok = true;
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Properties_ParallelFor(_sources.size(), threads, [&](size_t i) {
+    Source& source = *_sources[i];
+    if (source.kind == FILE_SOURCE) {
+      source.ok = source.mapped.open(source.file.c_str());
+    }
+  });
+  _timings.readMs = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  Properties_ParallelFor(_sources.size(), threads, [&](size_t i) {
+    Source& source = *_sources[i];
+    if (source.kind == FILE_SOURCE && source.ok) {
+      IniTokenizer tokenizer(source.mapped.view(), source.sep, true);
+      IniRecord record;
+      while (tokenizer.next(record)) {
+        source.records.push_back(record);
+      }
+    }
+  });
+  _timings.tokenizeMs = millisecondsSince(start);
+
+  start = std::chrono::steady_clock::now();
+  route();
+  _timings.routeMs = millisecondsSince(start);
+
+  bool ok = true;
+  for (size_t s = 0; s < _sources.size(); ++s) {
+    if (!_sources[s]->ok) {
+      for (size_t i = 0; i < _targets.size(); ++i) {
+        _targets[i].properties->_err << "ERROR: can't open file " << _sources[s]->file << "\n";
+      }
+      ok = false;
+      continue;
+    }
+    start = std::chrono::steady_clock::now();
+    Properties_ParallelFor(_targets.size(), threads, [&](size_t i) { apply(_targets[i], s); });
+    _timings.applyMs += millisecondsSince(start);
+
+    // the hooks of a source run before the next source is applied, on this thread and in object order, as
+    // consecutive loads would run them
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < _targets.size(); ++i) {
+      Target& target = _targets[i];
+      target.properties->_sectionFound = target.sectionFound[s] != 0;
+      target.properties->_loadFinished(_sources[s]->source, target.unknownFields[s]);
+    }
+    _timings.finishMs += millisecondsSince(start);
+  }
+  for (size_t i = 0; i < _targets.size(); ++i) {
+    Target& target = _targets[i];
+    // _loadFinished() already notified and published for the sources having the section; this covers the rest
+    if (target.properties->notifyChanged()) {
+      target.properties->publishSnapshot();
+    }
+    ok = ok && target.ok;
+  }
+
+  for (size_t s = 0; s < _sources.size(); ++s) {
+    _sources[s]->records.clear();
+    _sources[s]->mapped.close();
+  }
+  return ok;
+}
+
+void PropertiesLoadPipeline::route() {
+  std::unordered_map<std::string_view, std::vector<Target*>> routes;
+  for (size_t i = 0; i < _targets.size(); ++i) {
+    const MEtl::string& name = _targets[i].properties->getName();
+    routes[PropertiesSectionIndex::stripBrackets(std::string_view(name.data(), name.size()))].push_back(&_targets[i]);
+  }
+
+  for (size_t s = 0; s < _sources.size(); ++s) {
+    const Source& source = *_sources[s];
+    if (!source.ok) {
+      continue;
+    }
+    if (source.kind == FILE_SOURCE) {
+      // records of the same section are consecutive, so the route is looked up once per section
+      std::vector<Target*>* route = nullptr;
+      std::string_view section;
+      for (size_t r = 0; r < source.records.size(); ++r) {
+        const IniRecord& record = source.records[r];
+        if (r == 0 || record.section.data() != section.data() || record.section.size() != section.size()) {
+          section = record.section;
+          auto it = routes.find(PropertiesSectionIndex::stripBrackets(section));
+          route = (it == routes.end()) ? nullptr : &it->second;
+          for (size_t i = 0; route && i < route->size(); ++i) {
+            (*route)[i]->sectionFound[s] = 1;
+          }
+        }
+        if (!route || record.header) {
+          continue;
+        }
+        Record routed = {record.key, record.value};
+        for (size_t i = 0; i < route->size(); ++i) {
+          (*route)[i]->records[s].push_back(routed);
+        }
+        _timings.records += route->size();
+      }
+      continue;
+    }
+    for (size_t i = 0; i < _targets.size(); ++i) {
+      Target& target = _targets[i];
+      const MEtl::string& name = target.properties->getName();
+      std::string_view section = PropertiesSectionIndex::stripBrackets(std::string_view(name.data(), name.size()));
+      if (source.kind == COMMAND_LINE_SOURCE) {
+        const PropertiesCommandLine::Section* found = source.commandLine->find(section);
+        target.sectionFound[s] = (found != nullptr);
+        for (size_t a = 0; found && a < found->arguments.size(); ++a) {
+          Record routed = {found->arguments[a].key, found->arguments[a].value};
+          target.records[s].push_back(routed);
+        }
+      } else {
+        MEtl::string prefix = MEtl::string(section.data(), section.size()) + source.separator;
+        const PropertiesEnvironment::Variable* first;
+        const PropertiesEnvironment::Variable* last;
+        std::string_view view(prefix.data(), prefix.size());
+        target.sectionFound[s] = source.environment->find(view, first, last) != 0;
+        for (const PropertiesEnvironment::Variable* it = first; it != last; ++it) {
+          Record routed = {it->name.substr(prefix.size()), it->value};
+          if (!routed.key.empty()) {
+            target.records[s].push_back(routed);
+          }
+        }
+      }
+      _timings.records += target.records[s].size();
+    }
+  }
+}
+
+void PropertiesLoadPipeline::apply(Target& target, size_t source) {
+  const std::vector<Record>& records = target.records[source];
+  for (size_t r = 0; r < records.size(); ++r) {
+    MEtl::string value(records[r].value.data(), records[r].value.size());
+    if (!target.properties->_loadRecord(records[r].key, value, _sources[source]->source,
+                                        target.unknownFields[source])) {
+      target.ok = false;
+    }
+  }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file PropertiesLoadPipeline.h
+ */
+
+#ifndef __PROPERTIES_LOAD_PIPELINE__H__
+#define __PROPERTIES_LOAD_PIPELINE__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stddef.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class Properties;
+class PropertiesCommandLine;
+class PropertiesEnvironment;
+class MappedFile;
+
+/**
+ * @class PropertiesLoadPipeline
+ * @brief Loads many Properties objects from the same sources, reading and tokenizing every source once.
+ *
+ * Sources are added in the order of precedence (later sources override earlier ones, as with consecutive loads) and
+ * loaded by run() in stages:
+ *  - read: the files are memory mapped, concurrently;
+ *  - tokenize: the files are tokenized, concurrently;
+ *  - route: every record is routed in one pass to the objects whose section name (@see Properties::getName()) matches
+ *    its section; command line and environment slices are found with one lookup per object;
+ *  - apply and finish, one source after the other: each object loads the source's records (validation and sync() of
+ *    every value) on up to `threads` threads, one object per thread at a time; then the unknown fields policy,
+ *    notifyChanged(), onLoaded(), postLoaded() and publishSnapshot() run for each object having the source's section,
+ *    in object order on the calling thread. The hooks thus see the values of the sources loaded so far, as with
+ *    consecutive loads.
+ *
+ * Since objects are applied concurrently, their validate() and onRejected() hooks must not share unsynchronized state.
+ * The sources (files, command line and environment indexes) must outlive run().
+ */
+class PropertiesLoadPipeline {
+public:
+  /// @brief Wall clock time of each stage of run(), in milliseconds.
+  struct Timings {
+    double readMs;
+    double tokenizeMs;
+    double routeMs;
+    double applyMs;
+    double finishMs;
+    size_t records; /** < The number of records routed to an object, over all sources.*/
+  };
+
+  explicit PropertiesLoadPipeline(const std::vector<Properties*>& containers);
+  ~PropertiesLoadPipeline();
+
+  /**
+   * @brief Add an INI formatted file.
+   *
+   * @param[in] file The path to the file.
+   * @param[in] sep The separator between keys and values.
+   * @param[in] source The source the values are marked with (default: Property::FROM_INF).
+   */
+  void addFile(const MEtl::string& file, char sep, unsigned int source);
+  void addFile(const MEtl::string& file, char sep = '=');
+
+  /**
+   * @brief Add an indexed command line; each object loads the arguments of its section (Property::FROM_ARGS).
+   */
+  void addCommandLine(const PropertiesCommandLine& commandLine);
+
+  /**
+   * @brief Add an indexed environment; each object loads the variables named "<section name><separator><key>"
+   *        (Property::FROM_ENV).
+   */
+  void addEnvironment(const PropertiesEnvironment& environment, const MEtl::string& separator = "_");
+
+  /**
+   * @brief Load all sources into all objects.
+   *
+   * @param[in] threads The maximal number of threads to use, 0 for std::thread::hardware_concurrency().
+   * @return true if all files were read and all values were loaded successfully.
+   */
+  bool run(unsigned int threads = 0);
+
+  const Timings& timings() const { return _timings; }
+
+private:
+  PropertiesLoadPipeline(const PropertiesLoadPipeline& other);
+  PropertiesLoadPipeline& operator=(const PropertiesLoadPipeline& other);
+
+  struct Source;
+  struct Target;
+
+  void route();
+  void apply(Target& target, size_t source);
+
+  std::vector<Properties*> _containers;
+  std::vector<std::unique_ptr<Source>> _sources;
+  std::vector<Target> _targets;
+  Timings _timings;
+};
+
+#endif//__PROPERTIES_LOAD_PIPELINE__H__
@@ -0,0 +1,39 @@
+/**
+ * @file PropertiesParallel.cpp
+ */
+
+#include "PropertiesParallel.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+void Properties_ParallelFor(size_t count, unsigned int threads, const std::function<void(size_t)>& fn) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (threads > count) {
+    threads = static_cast<unsigned int>(count);
+  }
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      fn(i);
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned int i = 1; i < threads; ++i) {
+    workers.push_back(std::thread(worker));
+  }
+  worker();
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i].join();
+  }
+}
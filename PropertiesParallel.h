@@ -0,0 +1,24 @@
+/**
+ * @file PropertiesParallel.h
+ */
+
+#ifndef __PROPERTIES_PARALLEL__H__
+#define __PROPERTIES_PARALLEL__H__
+
+#include <stddef.h>
+
+#include <functional>
+
+/**
+ * @brief Runs fn(0) .. fn(count - 1) on up to `threads` threads and waits for all calls to return.
+ *
+ * Indices are handed out dynamically, so slow items (e.g. files on a slow disk) do not hold back the others.
+ * The calling thread takes part in the work. The order in which indices are processed is unspecified.
+ *
+ * @param[in] count The number of items.
+ * @param[in] threads The maximal number of threads to use, 0 for std::thread::hardware_concurrency().
+ * @param[in] fn The function to call for every item index.
+ */
+extern void Properties_ParallelFor(size_t count, unsigned int threads, const std::function<void(size_t)>& fn);
+
+#endif//__PROPERTIES_PARALLEL__H__
@@ -0,0 +1,89 @@
+/**
+ * @file PropertiesParallelTest.cpp
+ * @brief Tests of Properties_ParallelFor(): every index is processed exactly once, whatever the thread count.
+ */
+
+#include "PropertiesParallel.h"
+
+#include <stdio.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+void testEveryIndexOnce() {
+  const size_t COUNT = 1000;
+  const unsigned int threads[] = { 0, 1, 2, 4, 16, 5000 };
+  for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+    std::vector<std::atomic<int>> calls(COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+      calls[i] = 0;
+    }
+    Properties_ParallelFor(COUNT, threads[t], [&](size_t i) { ++calls[i]; });
+    size_t once = 0;
+    for (size_t i = 0; i < COUNT; ++i) {
+      once += calls[i] == 1;
+    }
+    CHECK(once == COUNT);
+  }
+}
+
+void testNothingToDo() {
+  int calls = 0;
+  Properties_ParallelFor(0, 4, [&](size_t) { ++calls; });
+  CHECK(calls == 0);
+}
+
+void testSequential() {
+  // a single thread runs the items in order, on the calling thread
+  std::vector<size_t> order;
+  const std::thread::id caller = std::this_thread::get_id();
+  bool onCaller = true;
+  Properties_ParallelFor(10, 1, [&](size_t i) {
+    order.push_back(i);
+    onCaller = onCaller && std::this_thread::get_id() == caller;
+  });
+  CHECK(order.size() == 10);
+  for (size_t i = 0; i < order.size(); ++i) {
+    CHECK(order[i] == i);
+  }
+  CHECK(onCaller);
+}
+
+void testCallerTakesPart() {
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  Properties_ParallelFor(64, 4, [&](size_t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ids.insert(std::this_thread::get_id());
+  });
+  CHECK(!ids.empty());
+  CHECK(ids.size() <= 4);
+}
+}// namespace
+
+int main() {
+  testEveryIndexOnce();
+  testNothingToDo();
+  testSequential();
+  testCallerTakesPart();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
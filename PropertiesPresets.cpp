@@ -0,0 +1,151 @@
+/**
+ * @file PropertiesPresets.cpp
+ */
+
+#include "PropertiesPresets.h"
+#include "Properties.h"
+#include "PropertiesSectionIndex.h"
+#include "PropertiesTokenizer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+typedef std::vector<std::pair<std::string_view, std::string_view>> Records;
+
+bool keyLess(const PropertiesPresets::Preset& a, const PropertiesPresets::Preset& b) {
+  return a.key < b.key;
+}
+}// namespace
+
+PropertiesPresets::PropertiesPresets(std::string_view buffer, char sep) {
+  // group the records by section; the views still point into the caller's buffer
+  std::vector<std::string_view> names;
+  std::vector<Records> grouped;
+  std::unordered_map<std::string_view, size_t> byName;
+  size_t size = 0;
+  IniTokenizer tokenizer(buffer, sep, true);
+  IniRecord record;
+  while (tokenizer.next(record)) {
+    std::string_view name = PropertiesSectionIndex::stripBrackets(record.section);
+    auto found = byName.find(name);
+    if (found == byName.end()) {
+      found = byName.insert(std::make_pair(name, names.size())).first;
+      names.push_back(name);
+      grouped.push_back(Records());
+      size += name.size();
+    }
+    if (!record.header) {
+      grouped[found->second].push_back(std::make_pair(record.key, record.value));
+      size += record.key.size() + record.value.size() + 1;
+    }
+  }
+
+  // copy into a buffer of the exact size, so the views into it stay valid
+  _buffer.reserve(size);
+  auto copy = [this](std::string_view str, bool terminate) {
+    const char* copied = _buffer.data() + _buffer.size();
+    _buffer.insert(_buffer.end(), str.begin(), str.end());
+    if (terminate) {
+      _buffer.push_back('\0');
+    }
+    return copied;
+  };
+  _sections.resize(names.size());
+  for (size_t s = 0; s < names.size(); ++s) {
+    Section& section = _sections[s];
+    section.name = std::string_view(copy(names[s], false), names[s].size());
+    section.first = _presets.size();
+    for (size_t r = 0; r < grouped[s].size(); ++r) {
+      Preset preset;
+      preset.key = std::string_view(copy(grouped[s][r].first, false), grouped[s][r].first.size());
+      preset.value = copy(grouped[s][r].second, true);
+      _presets.push_back(preset);
+    }
+    // sort by key; of repeated keys, the last one wins as it would when loading the section
+    std::vector<Preset>::iterator first = _presets.begin() + section.first;
+    std::stable_sort(first, _presets.end(), keyLess);
+    std::vector<Preset>::iterator out = first;
+    for (std::vector<Preset>::iterator it = first; it != _presets.end(); ++it) {
+      if (it + 1 != _presets.end() && (it + 1)->key == it->key) {
+        continue;
+      }
+      *out++ = *it;
+    }
+    _presets.erase(out, _presets.end());
+    section.count = _presets.size() - section.first;
+    _byName.insert(std::make_pair(section.name, s));
+  }
+}
+
+std::shared_ptr<const PropertiesPresets> PropertiesPresets::loadFile(const char* file, char sep,
+                                                                     MEtl::string& errMsg) {
+  MappedFile mapped;
+  if (!mapped.open(file)) {
+    errMsg = MEtl::string("can't open file ") + file;
+    return std::shared_ptr<const PropertiesPresets>();
+  }
+  return std::make_shared<const PropertiesPresets>(mapped.view(), sep);
+}
+
+const PropertiesPresets::Section* PropertiesPresets::find(std::string_view section) const {
+  auto found = _byName.find(PropertiesSectionIndex::stripBrackets(section));
+  return found == _byName.end() ? nullptr : &_sections[found->second];
+}
+
+const char* PropertiesPresets::find(const Section& section, std::string_view key) const {
+  Preset wanted;
+  wanted.key = key;
+  std::vector<Preset>::const_iterator first = _presets.begin() + section.first;
+  std::vector<Preset>::const_iterator last = first + section.count;
+  std::vector<Preset>::const_iterator found = std::lower_bound(first, last, wanted, keyLess);
+  return (found != last && found->key == key) ? found->value : nullptr;
+}
+
+const PropertiesPresets::Section* Properties::_presetSectionOf() const {
+  if (!_presets) {
+    return nullptr;
+  }
+  // the cached section is checked against the current name, so renaming the object needs no invalidation
+  const MEtl::string& name = getPresetName();
+  std::string_view wanted = PropertiesSectionIndex::stripBrackets(std::string_view(name.data(), name.size()));
+  const PropertiesPresets::Section* section = _presetSection.load(std::memory_order_acquire);
+  if (!section || section->name != wanted) {
+    // resolving is idempotent, so racing readers store the same result
+    section = _presets->find(wanted);
+    if (section) {
+      _presetSection.store(section, std::memory_order_release);
+    }
+  }
+  return section;
+}
+
+const char* Properties::presetValue(const MEtl::string& key) const {
+  const PropertiesPresets::Section* section = _presetSectionOf();
+  return section ? _presets->find(*section, std::string_view(key.data(), key.size())) : nullptr;
+}
+
+void Properties::setPresets(const std::shared_ptr<const PropertiesPresets>& presets) {
+  _presets = presets;
+  _presetSection.store(nullptr, std::memory_order_release);
+  if (!_presets) {
+    publishSnapshot();
+    return;
+  }
+  for (PropertiesIndex::Slot slot = 0; slot < _index.slots(); ++slot) {
+    const PropertiesIndex::Entry& entry = _index.at(slot);
+    if (!_index.property(slot)) {
+      continue;
+    }
+    // loaded, set and modified values override the preset
+    if ((entry.flags & PropertiesIndex::HAS_VALUE) &&
+        (entry.loaded != Property::NOT_LOADED || (entry.flags & PropertiesIndex::IS_MODIFIED))) {
+      continue;
+    }
+    const char* preset = presetValue(*entry.key);
+    if (preset) {
+      _setProperty(slot, MEtl::string(preset), Property::NOT_LOADED);
+    }
+  }
+  publishSnapshot();
+}
@@ -0,0 +1,87 @@
+/**
+ * @file PropertiesPresets.h
+ */
+
+#ifndef __PROPERTIES_PRESETS__H__
+#define __PROPERTIES_PRESETS__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stddef.h>
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class PropertiesPresets
+ * @brief An immutable table of preset values, shared by all Properties objects.
+ *
+ * The presets are read once, with one section per preset name (@see Properties::getPresetName()). The table is never
+ * modified after construction, so any number of objects and threads can read it. An object using the table looks its
+ * presets up on first access, instead of copying them in when it is created; a preset is copied into an object only
+ * when the object sets that key, or for the registered properties of the object when it attaches the table
+ * (@see Properties::setPresets()).
+ */
+class PropertiesPresets {
+public:
+  struct Preset {
+    std::string_view key;
+    const char* value; /** < Null terminated, owned by the table.*/
+  };
+
+  struct Section {
+    std::string_view name; /** < The section name without its brackets.*/
+    size_t first;          /** < The index of the first preset of the section.*/
+    size_t count;          /** < The number of presets of the section, sorted by key.*/
+  };
+
+  /**
+   * @brief Build the table from an INI formatted buffer. The buffer is copied.
+   *
+   * @param[in] buffer The presets, one section per preset name. Keys repeated within a section keep the last value.
+   * @param[in] sep The separator between keys and values.
+   */
+  PropertiesPresets(std::string_view buffer, char sep);
+
+  /**
+   * @brief Build a table from an INI formatted file.
+   *
+   * @param[in] file The path of the file.
+   * @param[in] sep The separator between keys and values.
+   * @param[out] errMsg Receives the reason of a failure.
+   * @return The table, or nullptr if the file could not be read.
+   */
+  static std::shared_ptr<const PropertiesPresets> loadFile(const char* file, char sep, MEtl::string& errMsg);
+
+  /**
+   * @brief Find the presets of a section.
+   *
+   * @param[in] section The section name, with or without brackets.
+   * @return The section, or nullptr if the table has no such section.
+   */
+  const Section* find(std::string_view section) const;
+
+  /**
+   * @brief Find a preset of a section.
+   *
+   * @param[in] section A section of this table.
+   * @param[in] key The key of the preset.
+   * @return The value of the preset, or nullptr if the section has no such key.
+   */
+  const char* find(const Section& section, std::string_view key) const;
+
+  const std::vector<Section>& sections() const { return _sections; }
+  const std::vector<Preset>& presets() const { return _presets; }
+
+private:
+  PropertiesPresets(const PropertiesPresets& other);
+  PropertiesPresets& operator=(const PropertiesPresets& other);
+
+  std::vector<char> _buffer; /** < The copied keys, values and section names, values are null terminated.*/
+  std::vector<Preset> _presets;
+  std::vector<Section> _sections;
+  std::unordered_map<std::string_view, size_t> _byName;
+};
+
+#endif//__PROPERTIES_PRESETS__H__
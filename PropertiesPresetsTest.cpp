@@ -0,0 +1,152 @@
+/**
+ * @file PropertiesPresetsTest.cpp
+ * @brief Tests of the shared preset table and of where Properties objects read it: getProperty(), snapshots and the
+ *        registered properties read the presets, properties() and store() do not.
+ */
+
+#include "Properties.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+const char* const PRESETS = "[camera]\n"
+                            "width=640\n"
+                            "mode=night\n"
+                            "width=1280\n"
+                            "[other]\n"
+                            "mode=day\n"
+                            "[empty]\n";
+
+struct CameraProperties : public Properties {
+  explicit CameraProperties(const char* section)
+      : Properties(section)
+      , width(this, 320, "width", "the image width", Property::DEFAULT_FLAGS) {}
+  ProperT<int> width;
+};
+
+std::shared_ptr<const PropertiesPresets> makePresets() {
+  return std::make_shared<const PropertiesPresets>(PRESETS, '=');
+}
+
+void testTable() {
+  PropertiesPresets presets(PRESETS, '=');
+  CHECK(presets.sections().size() == 3);
+  const PropertiesPresets::Section* camera = presets.find("[camera]");
+  CHECK(camera != nullptr);
+  CHECK(camera == presets.find("camera"));
+  if (camera) {
+    CHECK(camera->count == 2);
+    // a repeated key keeps its last value
+    CHECK(std::string(presets.find(*camera, "width")) == "1280");
+    CHECK(std::string(presets.find(*camera, "mode")) == "night");
+    CHECK(presets.find(*camera, "missing") == nullptr);
+  }
+  const PropertiesPresets::Section* empty = presets.find("empty");
+  CHECK(empty != nullptr && empty->count == 0);
+  CHECK(presets.find("missing") == nullptr);
+}
+
+void testLookups() {
+  CameraProperties properties("camera");
+  properties.setPresets(makePresets());
+  // the registered property is set to its preset when the table is attached, the free key is read lazily
+  CHECK(properties.getProperty(MEtl::string("width"), 0) == 1280);
+  bool exist = false;
+  CHECK(properties.getProperty(MEtl::string("mode"), MEtl::string(), &exist) == MEtl::string("night"));
+  CHECK(exist);
+  CHECK(std::string(properties.presetValue(MEtl::string("mode"))) == "night");
+
+  // a set value overrides the preset, which stays readable through presetValue()
+  properties.setProperty(MEtl::string("mode"), MEtl::string("dusk"));
+  CHECK(properties.getProperty(MEtl::string("mode"), MEtl::string()) == MEtl::string("dusk"));
+  CHECK(std::string(properties.presetValue(MEtl::string("mode"))) == "night");
+}
+
+void testLoadedValueWins() {
+  CameraProperties properties("camera");
+  properties.load(MEtl::string("width=800\n"), '=');
+  properties.setPresets(makePresets());
+  CHECK(properties.getProperty(MEtl::string("width"), 0) == 800);
+}
+
+void testPresetName() {
+  CameraProperties properties("camera");
+  properties.setPresets(makePresets());
+  properties.setName("other");
+  // the section is resolved again after the rename
+  CHECK(properties.getProperty(MEtl::string("mode"), MEtl::string()) == MEtl::string("day"));
+  properties.setName("missing");
+  bool exist = true;
+  properties.getProperty(MEtl::string("mode"), MEtl::string(), &exist);
+  CHECK(!exist);
+}
+
+void testNotStored() {
+  CameraProperties properties("camera");
+  properties.setPresets(makePresets());
+  // the preset only free key is not a value of the object
+  CHECK(properties.properties().count(MEtl::string("mode")) == 0);
+  std::ostringstream out;
+  properties.store(out, Properties::STORE_FREE_PARAMS, '=');
+  CHECK(out.str().find("mode") == std::string::npos);
+
+  properties.setProperty(MEtl::string("mode"), MEtl::string("dusk"));
+  CHECK(properties.properties().count(MEtl::string("mode")) == 1);
+}
+
+void testSnapshots() {
+  CameraProperties properties("camera");
+  properties.enableSnapshots();
+  {
+    PropertiesSnapshotReader reader = properties.snapshot();
+    CHECK(reader);
+    CHECK(reader->getProperty(MEtl::string("mode")) == nullptr);
+  }
+  // attaching the table publishes a snapshot that reads the presets, for free keys and registered properties alike
+  properties.setPresets(makePresets());
+  {
+    PropertiesSnapshotReader reader = properties.snapshot();
+    CHECK(reader->getProperty(MEtl::string("mode"), MEtl::string()) == MEtl::string("night"));
+    CHECK(reader->getProperty(MEtl::string("width"), 0) == 1280);
+    CHECK(reader->properties().count(MEtl::string("mode")) == 0);
+  }
+  // a snapshot keeps the section it was published with
+  PropertiesSnapshotReader before = properties.snapshot();
+  properties.setName("other");
+  properties.publishSnapshot();
+  CHECK(before->getProperty(MEtl::string("mode"), MEtl::string()) == MEtl::string("night"));
+  CHECK(properties.snapshot()->getProperty(MEtl::string("mode"), MEtl::string()) == MEtl::string("day"));
+
+  properties.setPresets(nullptr);
+  CHECK(properties.snapshot()->getProperty(MEtl::string("mode")) == nullptr);
+}
+}// namespace
+
+int main() {
+  testTable();
+  testLookups();
+  testLoadedValueWins();
+  testPresetName();
+  testNotStored();
+  testSnapshots();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file PropertiesSectionIndex.cpp
+ */
+
+#include "PropertiesSectionIndex.h"
+#include "Properties.h"
+#include "PropertiesTokenizer.h"
+
+#include <string.h>
+
+PropertiesSectionIndex::PropertiesSectionIndex(const MEtl::string& iniStr)
+    : _buffer(iniStr.data(), iniStr.size()) {
+  build();
+}
+
+PropertiesSectionIndex::PropertiesSectionIndex(std::string_view buffer)
+    : _buffer(buffer) {
+  build();
+}
+
+std::string_view PropertiesSectionIndex::stripBrackets(std::string_view section) {
+  section = IniTokenizer::trim(section);
+  if (section.size() >= 2 && section.front() == '[' && section.back() == ']') {
+    section = IniTokenizer::trim(section.substr(1, section.size() - 2));
+  }
+  return section;
+}
+
+void PropertiesSectionIndex::build() {
+  size_t pos = 0;
+  while (pos < _buffer.size()) {
+    const char* line = _buffer.data() + pos;
+    size_t remaining = _buffer.size() - pos;
+    const char* eol = static_cast<const char*>(memchr(line, '\n', remaining));
+    size_t len = eol ? static_cast<size_t>(eol - line) : remaining;
+    size_t next = eol ? pos + len + 1 : pos + len;
+
+    std::string_view text = IniTokenizer::trim(std::string_view(line, len));
+    size_t close = text.find(']');
+    if (!text.empty() && text[0] == '[' && close != std::string_view::npos) {
+      if (!_sections.empty()) {
+        Section& last = _sections.back();
+        last.dataSize = pos - last.dataOffset;
+      }
+      Section section;
+      section.name = stripBrackets(text.substr(0, close + 1));
+      section.headerOffset = text.data() - _buffer.data();
+      section.dataOffset = next;
+      section.dataSize = 0;
+      _sections.push_back(section);
+    }
+    pos = next;
+  }
+  if (!_sections.empty()) {
+    Section& last = _sections.back();
+    last.dataSize = _buffer.size() - last.dataOffset;
+  }
+  _byName.reserve(_sections.size());
+  for (size_t i = 0; i < _sections.size(); ++i) {
+    _byName.insert(std::make_pair(_sections[i].name, i));
+  }
+}
+
+const PropertiesSectionIndex::Section* PropertiesSectionIndex::find(std::string_view section) const {
+  std::unordered_map<std::string_view, size_t>::const_iterator it = _byName.find(stripBrackets(section));
+  if (it == _byName.end()) {
+    return nullptr;
+  }
+  return &_sections[it->second];
+}
+
+std::string_view PropertiesSectionIndex::data(std::string_view section) const {
+  const Section* found = find(section);
+  if (!found) {
+    return std::string_view();
+  }
+  return _buffer.substr(found->dataOffset, found->dataSize);
+}
+
+bool Properties_isSectionExist(const MEtl::string& section, const PropertiesSectionIndex& index) {
+  return index.find(std::string_view(section.data(), section.size())) != nullptr;
+}
+
+bool Properties_GetMapOfSections(std::map<MEtl::string, MEtl::string>& sections, const PropertiesSectionIndex& index) {
+  sections.clear();
+  const std::vector<PropertiesSectionIndex::Section>& all = index.sections();
+  for (size_t i = 0; i < all.size(); ++i) {
+    // a repeated section replaces the data of its earlier occurrences
+    MEtl::string name(all[i].name.data(), all[i].name.size());
+    std::string_view data = index.buffer().substr(all[i].dataOffset, all[i].dataSize);
+    sections[name] = MEtl::string(data.data(), data.size());
+  }
+  return !all.empty();
+}
+
+bool Properties_GetSectionData(const char* section, const PropertiesSectionIndex& index, MEtl::string& data) {
+  const PropertiesSectionIndex::Section* found = index.find(section ? section : "");
+  if (!found) {
+    return false;
+  }
+  std::string_view view = index.buffer().substr(found->dataOffset, found->dataSize);
+  data.assign(view.data(), view.size());
+  return true;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file PropertiesSectionIndex.h
+ */
+
+#ifndef __PROPERTIES_SECTION_INDEX__H__
+#define __PROPERTIES_SECTION_INDEX__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stddef.h>
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class PropertiesSectionIndex
+ * @brief A build-once index of the sections of an INI-formatted buffer.
+ *
+ * The buffer is scanned once on construction; afterwards the data of any section is found with a single hash lookup.
+ * Section names are accepted with or without their square brackets. If a section appears more than once, the first
+ * occurrence is indexed, as Properties_GetSectionData() does.
+ *
+ * The index refers to the buffer and does not copy it: the buffer must outlive the index and must not be modified.
+ */
+class PropertiesSectionIndex {
+public:
+  struct Section {
+    std::string_view name;   /** < The section name without its brackets.*/
+    size_t headerOffset;     /** < Offset of the '[' of the section header line.*/
+    size_t dataOffset;       /** < Offset of the first line following the section header.*/
+    size_t dataSize;         /** < Size of the section data, up to the next section header or the end of the buffer.*/
+  };
+
+  explicit PropertiesSectionIndex(const MEtl::string& iniStr);
+  explicit PropertiesSectionIndex(std::string_view buffer);
+
+  /**
+   * @brief Find a section by name.
+   *
+   * @param[in] section The section name, with or without brackets.
+   * @return The section, or nullptr if the buffer has no such section.
+   */
+  const Section* find(std::string_view section) const;
+
+  /**
+   * @brief Get the data of a section (the lines between its header and the next section header).
+   *
+   * @param[in] section The section name, with or without brackets.
+   * @return A view into the buffer, empty if the section does not exist.
+   */
+  std::string_view data(std::string_view section) const;
+
+  /// @brief Get the sections in their order of appearance.
+  const std::vector<Section>& sections() const { return _sections; }
+
+  std::string_view buffer() const { return _buffer; }
+
+  static std::string_view stripBrackets(std::string_view section);
+
+private:
+  void build();
+
+  std::string_view _buffer;
+  std::vector<Section> _sections;
+  std::unordered_map<std::string_view, size_t> _byName;
+};
+
+#endif//__PROPERTIES_SECTION_INDEX__H__
@@ -0,0 +1,113 @@
+/**
+ * @file PropertiesSectionIndexTest.cpp
+ * @brief Tests of PropertiesSectionIndex: the indexed section lookups must answer as the scans of the buffer do.
+ */
+
+#include "Properties.h"
+#include "PropertiesSectionIndex.h"
+
+#include <stdio.h>
+
+#include <map>
+#include <sstream>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+const MEtl::string INI("free=0\n"
+                       "[first]\n"
+                       "a=1\n"
+                       "b=2\n"
+                       "  [ second ]  \n"
+                       "c=3\n"
+                       "[empty]\n"
+                       "[first]\n"
+                       "a=4\n"
+                       "[last]\n"
+                       "d=5");
+
+void testSections() {
+  PropertiesSectionIndex index(INI);
+  CHECK(index.sections().size() == 5);
+  CHECK(index.sections()[1].name == "second");
+
+  const PropertiesSectionIndex::Section* first = index.find("first");
+  CHECK(first != nullptr);
+  CHECK(first == index.find("[first]"));
+  CHECK(first == index.find(" [ first ] "));
+  // a repeated section is found at its first occurrence
+  CHECK(first == &index.sections()[0]);
+  CHECK(index.data("first") == "a=1\nb=2\n");
+  CHECK(index.data("second") == "c=3\n");
+  CHECK(index.data("empty").empty());
+  CHECK(index.find("empty") != nullptr);
+  // the last section has no line feed
+  CHECK(index.data("last") == "d=5");
+  CHECK(index.find("missing") == nullptr);
+  CHECK(index.data("missing").empty());
+
+  PropertiesSectionIndex none(std::string_view("a=1\n"));
+  CHECK(none.sections().empty());
+  PropertiesSectionIndex blank((std::string_view()));
+  CHECK(blank.sections().empty());
+}
+
+void testSameAsScan() {
+  PropertiesSectionIndex index(INI);
+  const char* const names[] = { "first", "[second]", "empty", "last", "missing" };
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+    MEtl::string name(names[i]);
+    CHECK(Properties_isSectionExist(name, index) == Properties_isSectionExist(name, INI));
+    MEtl::string scanned;
+    MEtl::string indexed;
+    const bool found = Properties_GetSectionData(names[i], INI, scanned);
+    CHECK(Properties_GetSectionData(names[i], index, indexed) == found);
+    if (found) {
+      CHECK(indexed == scanned);
+    }
+  }
+
+  std::map<MEtl::string, MEtl::string> scanned;
+  std::map<MEtl::string, MEtl::string> indexed;
+  CHECK(Properties_GetMapOfSections(indexed, index) == Properties_GetMapOfSections(scanned, INI));
+  CHECK(indexed == scanned);
+}
+
+void testLoad() {
+  PropertiesSectionIndex index(INI);
+  Properties fromIndex("first");
+  Properties fromString("first");
+  CHECK(fromIndex.load(index, '=', "first"));
+  CHECK(fromString.load(INI, '=', "first"));
+  std::ostringstream expected;
+  fromString.store(expected, Properties::STORE_FREE_PARAMS, '=');
+  std::ostringstream actual;
+  fromIndex.store(actual, Properties::STORE_FREE_PARAMS, '=');
+  CHECK(actual.str() == expected.str());
+  CHECK(fromIndex.getProperty(MEtl::string("b"), 0) == 2);
+
+  Properties missing("missing");
+  CHECK(missing.load(index, '=', "missing"));
+  CHECK(!missing.getLastLoadCallSectionFound());
+}
+}// namespace
+
+int main() {
+  testSections();
+  testSameAsScan();
+  testLoad();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,11 @@
+/**
+ * @file PropertiesSnapshot.cpp
+ */
+
+#include "PropertiesSnapshot.h"
+
+EpochDomain& PropertiesSnapshot::domain() {
+  // never destroyed: Properties objects with static storage duration retire their snapshots on exit
+  static EpochDomain* domain = new EpochDomain();
+  return *domain;
+}
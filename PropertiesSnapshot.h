@@ -0,0 +1,156 @@
+/**
+ * @file PropertiesSnapshot.h
+ */
+
+#ifndef __PROPERTIES_SNAPSHOT__H__
+#define __PROPERTIES_SNAPSHOT__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "EpochDomain.h"
+#include "PropertiesConvert.h"
+#include "PropertiesIndex.h"
+#include "PropertiesPresets.h"
+#include "ProperTypes.h"
+
+/**
+ * @class PropertiesSnapshot
+ * @brief An immutable copy of the values of a Properties object, safe to read from any number of threads.
+ *
+ * A snapshot keeps the shared preset table of its object (@see Properties::setPresets()) and the preset section that
+ * was current when it was published, so getProperty() falls back to the presets exactly as the object does.
+ */
+class PropertiesSnapshot {
+public:
+  PropertiesSnapshot(const PropertiesIndex& index, uint64_t version,
+                     const std::shared_ptr<const PropertiesPresets>& presets = nullptr,
+                     const PropertiesPresets::Section* presetSection = nullptr)
+      : _index(index)
+      , _version(version)
+      , _presets(presetSection ? presets : nullptr)
+      , _presetSection(presetSection) {}
+
+  /**
+   * @brief Get the value of a property as a C-style string.
+   *
+   * @param[in] key The key of the property to retrieve.
+   * @return The property's value, or its preset if the property had no value when the snapshot was published, or
+   *         nullptr if it had neither.
+   */
+  const char* getProperty(const MEtl::string& key) const {
+    const char* value = _index.value(_index.find(key));
+    if (!value && _presetSection) {
+      value = _presets->find(*_presetSection, std::string_view(key.data(), key.size()));
+    }
+    return value;
+  }
+
+  /**
+   * @brief Get the value of a property converted to T.
+   *
+   * @tparam T The type to which the property value will be converted.
+   * @param[in] key The key of the property to retrieve.
+   * @param[in] defaultVal The default value to return if the property doesn't exist.
+   * @param[in] pexist A pointer to a bool indicating if the property exists (default: nullptr).
+   * @return The property's value of type T, or the default value if the property is not found.
+   */
+  template<typename T>
+  T getProperty(const MEtl::string& key, const T& defaultVal, bool* pexist = nullptr) const {
+    const char* valString = getProperty(key);
+    if (pexist) {
+      *pexist = (valString != nullptr);
+    }
+    if (!valString) {
+      return defaultVal;
+    }
+    T nonConstDefaultVal(defaultVal);
+    return PropertyConvert<T>::fromString(nonConstDefaultVal, MEtl::string(valString));
+  }
+
+  /// @brief The values of the object, without the presets, as Properties::properties().
+  PropertiesIndex::ValueView properties() const { return _index.valueView(); }
+
+  /// @brief The version of the snapshot; every publication of a Properties object increments it.
+  uint64_t version() const { return _version; }
+
+  /// @brief The reclamation domain shared by all snapshots.
+  static EpochDomain& domain();
+
+private:
+  const PropertiesIndex _index;
+  const uint64_t _version;
+  const std::shared_ptr<const PropertiesPresets> _presets;
+  const PropertiesPresets::Section* const _presetSection; /** < Points into _presets, nullptr without presets.*/
+};
+
+/**
+ * @class PropertiesSnapshotReader
+ * @brief Keeps a snapshot alive for the lifetime of the reader.
+ *
+ * Obtained from Properties::snapshot(). The snapshot it points to is consistent and never changes; a later publication
+ * does not affect it. Readers should be short lived, as they hold back the reclamation of replaced snapshots.
+ */
+class PropertiesSnapshotReader {
+public:
+  PropertiesSnapshotReader(EpochDomain& domain, const std::atomic<const PropertiesSnapshot*>& current)
+      : _guard(domain)
+      , _snapshot(current.load()) {}
+
+  /// @brief false if no snapshot was published yet.
+  explicit operator bool() const { return _snapshot != nullptr; }
+  const PropertiesSnapshot* operator->() const { return _snapshot; }
+  const PropertiesSnapshot& operator*() const { return *_snapshot; }
+
+private:
+  EpochDomain::Guard _guard;
+  const PropertiesSnapshot* _snapshot;
+};
+
+/**
+ * @class PropertiesSnapshotSlot
+ * @brief The publication point of the snapshots of one Properties object.
+ *
+ * The writer (the thread loading and setting properties) publishes a new snapshot with an atomic pointer swap; the
+ * replaced snapshot is retired to the epoch domain and deleted once no reader can see it anymore. Publishing is a
+ * no-op until snapshots are enabled, so containers nobody reads concurrently pay nothing.
+ */
+class PropertiesSnapshotSlot {
+public:
+  PropertiesSnapshotSlot()
+      : _current(nullptr)
+      , _version(0)
+      , _enabled(false) {}
+  ~PropertiesSnapshotSlot() { PropertiesSnapshot::domain().retire(_current.exchange(nullptr)); }
+
+  void enable(const PropertiesIndex& index, const std::shared_ptr<const PropertiesPresets>& presets = nullptr,
+              const PropertiesPresets::Section* presetSection = nullptr) {
+    _enabled = true;
+    publish(index, presets, presetSection);
+  }
+  bool enabled() const { return _enabled; }
+
+  void publish(const PropertiesIndex& index, const std::shared_ptr<const PropertiesPresets>& presets = nullptr,
+               const PropertiesPresets::Section* presetSection = nullptr) {
+    if (!_enabled) {
+      return;
+    }
+    const PropertiesSnapshot* snapshot = new PropertiesSnapshot(index, ++_version, presets, presetSection);
+    PropertiesSnapshot::domain().retire(_current.exchange(snapshot));
+  }
+
+  PropertiesSnapshotReader read() const { return PropertiesSnapshotReader(PropertiesSnapshot::domain(), _current); }
+
+private:
+  PropertiesSnapshotSlot(const PropertiesSnapshotSlot& other);
+  PropertiesSnapshotSlot& operator=(const PropertiesSnapshotSlot& other);
+
+  std::atomic<const PropertiesSnapshot*> _current;
+  uint64_t _version;
+  bool _enabled;
+};
+
+#endif//__PROPERTIES_SNAPSHOT__H__
@@ -0,0 +1,116 @@
+/**
+ * @file PropertiesSnapshotTest.cpp
+ * @brief Tests of Properties snapshots: a snapshot is a consistent copy that later loads and sets do not change.
+ */
+
+#include "Properties.h"
+#include "PropertiesSectionIndex.h"
+
+#include <stdio.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+struct SnapshotProperties : public Properties {
+  SnapshotProperties()
+      : Properties("snapshot")
+      , width(this, 640, "width", "the image width", Property::DEFAULT_FLAGS)
+      , height(this, 480, "height", "the image height", Property::DEFAULT_FLAGS) {}
+  ProperT<int> width;
+  ProperT<int> height;
+};
+
+void testDisabled() {
+  SnapshotProperties properties;
+  properties.publishSnapshot();
+  CHECK(!properties.snapshot());
+}
+
+void testPublish() {
+  SnapshotProperties properties;
+  properties.enableSnapshots();
+  PropertiesSnapshotReader first = properties.snapshot();
+  CHECK(first);
+  CHECK(first->getProperty(MEtl::string("width"), 0) == 640);
+  const uint64_t version = first->version();
+
+  // a load of the single pass loaders publishes, a set does not until publishSnapshot()
+  const MEtl::string text("width=800\nfree=text\n");
+  properties.load(PropertiesSectionIndex(text), '=');
+  PropertiesSnapshotReader loaded = properties.snapshot();
+  CHECK(loaded->version() > version);
+  CHECK(loaded->getProperty(MEtl::string("width"), 0) == 800);
+  CHECK(MEtl::string(loaded->getProperty(MEtl::string("free"))) == "text");
+  CHECK(loaded->properties().count(MEtl::string("free")) == 1);
+
+  properties.setProperty(MEtl::string("height"), 600);
+  CHECK(properties.snapshot()->version() == loaded->version());
+  CHECK(properties.snapshot()->getProperty(MEtl::string("height"), 0) == 480);
+  properties.publishSnapshot();
+  CHECK(properties.snapshot()->getProperty(MEtl::string("height"), 0) == 600);
+
+  // held snapshots never change
+  CHECK(first->getProperty(MEtl::string("width"), 0) == 640);
+  CHECK(first->getProperty(MEtl::string("free")) == nullptr);
+  bool exist = true;
+  CHECK(first->getProperty(MEtl::string("free"), MEtl::string("none"), &exist) == MEtl::string("none"));
+  CHECK(!exist);
+  CHECK(loaded->getProperty(MEtl::string("height"), 0) == 480);
+}
+
+void testConcurrentReaders() {
+  SnapshotProperties properties;
+  properties.enableSnapshots();
+  std::atomic<bool> done(false);
+  std::atomic<int> inconsistent(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.push_back(std::thread([&]() {
+      while (!done.load()) {
+        PropertiesSnapshotReader snapshot = properties.snapshot();
+        // width and height are always published together
+        const int width = snapshot->getProperty(MEtl::string("width"), 0);
+        const int height = snapshot->getProperty(MEtl::string("height"), 0);
+        if (width * 3 != height * 4) {
+          ++inconsistent;
+        }
+      }
+    }));
+  }
+  for (int i = 1; i <= 2000; ++i) {
+    properties.setProperty(MEtl::string("width"), 4 * i);
+    properties.setProperty(MEtl::string("height"), 3 * i);
+    properties.publishSnapshot();
+  }
+  done = true;
+  for (size_t r = 0; r < readers.size(); ++r) {
+    readers[r].join();
+  }
+  CHECK(inconsistent == 0);
+  CHECK(properties.snapshot()->getProperty(MEtl::string("width"), 0) == 8000);
+}
+}// namespace
+
+int main() {
+  testDisabled();
+  testPublish();
+  testConcurrentReaders();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file PropertiesStore.cpp
+ * @brief Storing of Properties into caller supplied buffers, without allocating the output.
+ */
+
+#include "Properties.h"
+#include "PropertiesSectionIndex.h"
+
+#include <string.h>
+
+#include <ostream>
+#include <streambuf>
+
+/**
+ * @brief Stream buffer of _storeTo(). Counts every byte and copies those that fit; a null buffer only counts.
+ *        It never allocates, so store() writes through it straight into the caller's buffer.
+ */
+struct Properties::StoreSink : public std::streambuf {
+  StoreSink(char* buf, size_t capacity)
+      : _buf(buf)
+      , _capacity(buf ? capacity : 0)
+      , _size(0) {}
+
+  void append(const char* str, size_t len) {
+    if (_size + len <= _capacity) {
+      memcpy(_buf + _size, str, len);
+    }
+    _size += len;
+  }
+
+  size_t size() const { return _size; }
+  bool truncated() const { return _size > _capacity; }
+
+protected:
+  virtual std::streamsize xsputn(const char* str, std::streamsize len) {
+    append(str, static_cast<size_t>(len));
+    return len;
+  }
+  virtual int_type overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      char ch = traits_type::to_char_type(c);
+      append(&ch, 1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+private:
+  char* _buf;
+  size_t _capacity;
+  size_t _size;
+};
+
+void Properties::_storeTo(StoreSink& sink, char sep, const char* section, int flags) const {
+  if (section) {
+    std::string_view name = PropertiesSectionIndex::stripBrackets(section);
+    sink.append("[", 1);
+    sink.append(name.data(), name.size());
+    sink.append("]\n", 2);
+  }
+  // store() itself selects and formats the values, so every StoreOptions flag gives exactly its output
+  std::ostream out(&sink);
+  store(out, flags, sep);
+}
+
+size_t Properties::storedSize(char sep, const char* section, int flags) const {
+  StoreSink sink(nullptr, 0);
+  _storeTo(sink, sep, section, flags);
+  return sink.size();
+}
+
+size_t Properties::storeBuffer(char* buf, size_t bufSize, char sep, const char* section, int flags) const {
+  StoreSink sink(buf, bufSize);
+  _storeTo(sink, sep, section, flags);
+  if (sink.truncated()) {
+    return 0;
+  }
+  if (sink.size() < bufSize) {
+    buf[sink.size()] = '\0';
+  }
+  return sink.size();
+}
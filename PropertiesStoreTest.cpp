@@ -0,0 +1,114 @@
+/**
+ * @file PropertiesStoreTest.cpp
+ * @brief Tests of storedSize() and storeBuffer(): their output must be byte-identical to store() and storeString().
+ */
+
+#include "Properties.h"
+
+#include <stdio.h>
+
+#include <sstream>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+/// @brief One property per store-relevant property flag, each loaded, set or left at its default by the test.
+struct StoreProperties : public Properties {
+  StoreProperties()
+      : Properties("store")
+      , persistent(this, 1, "persistent", "a persistent value", Property::DEFAULT_FLAGS)
+      , volatileVal(this, 2, "volatileVal", "a volatile value", Property::VOLATILE)
+      , visible(this, 3, "visible", "a visible value", Property::VISIBLE)
+      , always(this, 4, "always", "always stored", Property::ALWAYS)
+      , ifNotDefault(this, 5, "ifNotDefault", "stored if not default", Property::IF_NOT_DEFAULT)
+      , ifUser(this, 6, "ifUser", "stored if set by the user", Property::IF_USER)
+      , ifCalib(this, 7, "ifCalib", "stored if calibrated", Property::DEFAULT_ME_FLAGS)
+      , ifUserOrCalib(this, 8, "ifUserOrCalib", "stored if set or calibrated", Property::IF_USER_OR_CALIB)
+      , forbidden(this, 9, "forbidden", "a forbidden value", Property::FORBIDDEN)
+      , deprecated(this, 10, "deprecated", "a deprecated value", Property::DEPRECATED)
+      , checksummed(this, 11.5, "checksummed", "a checksummed value", Property::DEFAULT_FLAGS | Property::CHECKSUM) {}
+  ProperT<int> persistent;
+  ProperT<int> volatileVal;
+  ProperT<int> visible;
+  ProperT<int> always;
+  ProperT<int> ifNotDefault;
+  ProperT<int> ifUser;
+  ProperT<int> ifCalib;
+  ProperT<int> ifUserOrCalib;
+  ProperT<int> forbidden;
+  ProperT<int> deprecated;
+  ProperT<double> checksummed;
+};
+
+const int STORE_OPTIONS_FIRST = Properties::STORE_DESCRIPTION;
+
+void fill(StoreProperties& properties) {
+  properties.load(MEtl::string("persistent=21\nifCalib=27\nifUserOrCalib=28\nchecksummed=2.25\nfree=text\n"), '=');
+  properties.setProperty(MEtl::string("ifUser"), 26);
+  properties.setProperty(MEtl::string("userFree"), MEtl::string("set"));
+}
+
+void testEveryFlagCombination() {
+  StoreProperties properties;
+  fill(properties);
+  std::vector<char> buf;
+  for (int mask = 0; mask < (1 << Properties::StoreOptionsSize); ++mask) {
+    const int flags = mask * STORE_OPTIONS_FIRST;
+    std::ostringstream expected;
+    properties.store(expected, flags, '=');
+    const size_t size = properties.storedSize('=', nullptr, flags);
+    CHECK(size == expected.str().size());
+    buf.assign(size + 1, '\0');
+    CHECK(properties.storeBuffer(buf.data(), buf.size(), '=', nullptr, flags) == size);
+    CHECK(MEtl::string(buf.data(), size) == MEtl::string(expected.str()));
+  }
+}
+
+void testSection() {
+  StoreProperties properties;
+  fill(properties);
+  for (int mask = 0; mask < (1 << Properties::StoreOptionsSize); ++mask) {
+    const int flags = mask * STORE_OPTIONS_FIRST;
+    MEtl::string expected;
+    properties.storeString(expected, ':', "store", flags);
+    std::vector<char> buf(properties.storedSize(':', "store", flags) + 1, '\0');
+    const size_t size = properties.storeBuffer(buf.data(), buf.size(), ':', "store", flags);
+    CHECK(MEtl::string(buf.data(), size) == expected);
+    // the section may be given with its brackets as well
+    CHECK(properties.storedSize(':', "[store]", flags) == size);
+  }
+}
+
+void testTooSmall() {
+  StoreProperties properties;
+  fill(properties);
+  const size_t size = properties.storedSize('=');
+  CHECK(size > 0);
+  std::vector<char> buf(size, 'x');
+  // exactly the size fits without the terminating NUL
+  CHECK(properties.storeBuffer(buf.data(), buf.size(), '=') == size);
+  CHECK(properties.storeBuffer(buf.data(), size - 1, '=') == 0);
+  CHECK(properties.storeBuffer(nullptr, 0, '=') == 0);
+}
+}// namespace
+
+int main() {
+  testEveryFlagCombination();
+  testSection();
+  testTooSmall();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
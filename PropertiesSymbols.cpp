@@ -0,0 +1,86 @@
+/**
+ * @file PropertiesSymbols.cpp
+ */
+
+#include "PropertiesSymbols.h"
+#include "PropertiesIndex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+const unsigned int CHUNK_BITS = 12;
+const size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+const size_t MAX_CHUNKS = 4096;
+
+struct Symbol {
+  MEtl::string name;
+  uint64_t hash;
+};
+
+// symbols live in fixed size chunks that are never moved, so ids resolve without a lock
+struct SymbolTable {
+  std::mutex mutex; /** < Serializes intern() only.*/
+  std::unordered_map<std::string_view, PropertiesSymbols::Id> ids;
+  std::atomic<Symbol*> chunks[MAX_CHUNKS];
+  std::atomic<size_t> count;
+};
+
+SymbolTable& table() {
+  // intentionally leaked: symbols may be used by static objects during exit
+  static SymbolTable* symbols = new SymbolTable();
+  return *symbols;
+}
+
+const Symbol& symbol(PropertiesSymbols::Id id) {
+  size_t i = id - 1;
+  return table().chunks[i >> CHUNK_BITS].load(std::memory_order_acquire)[i & (CHUNK_SIZE - 1)];
+}
+}// namespace
+
+PropertiesSymbols::Id PropertiesSymbols::intern(const char* str, size_t len, uint64_t strHash) {
+  SymbolTable& symbols = table();
+  std::lock_guard<std::mutex> lock(symbols.mutex);
+  std::unordered_map<std::string_view, Id>::const_iterator it = symbols.ids.find(std::string_view(str, len));
+  if (it != symbols.ids.end()) {
+    return it->second;
+  }
+  size_t i = symbols.count.load(std::memory_order_relaxed);
+  if ((i >> CHUNK_BITS) >= MAX_CHUNKS) {
+    fprintf(stderr, "ERROR: too many property symbols\n");
+    abort();
+  }
+  Symbol* chunk = symbols.chunks[i >> CHUNK_BITS].load(std::memory_order_relaxed);
+  if (!chunk) {
+    chunk = new Symbol[CHUNK_SIZE];
+    symbols.chunks[i >> CHUNK_BITS].store(chunk, std::memory_order_release);
+  }
+  Symbol& added = chunk[i & (CHUNK_SIZE - 1)];
+  added.name.assign(str, len);
+  added.hash = strHash;
+  symbols.count.store(i + 1, std::memory_order_release);
+  Id id = static_cast<Id>(i + 1);
+  symbols.ids.insert(std::make_pair(std::string_view(added.name.data(), added.name.size()), id));
+  return id;
+}
+
+PropertiesSymbols::Id PropertiesSymbols::intern(const MEtl::string& str) {
+  return intern(str.data(), str.size(), PropertiesIndex::hash(str.data(), str.size()));
+}
+
+const MEtl::string& PropertiesSymbols::name(Id id) {
+  return symbol(id).name;
+}
+
+uint64_t PropertiesSymbols::hash(Id id) {
+  return symbol(id).hash;
+}
+
+size_t PropertiesSymbols::size() {
+  return table().count.load(std::memory_order_acquire);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file PropertiesSymbols.h
+ */
+
+#ifndef __PROPERTIES_SYMBOLS__H__
+#define __PROPERTIES_SYMBOLS__H__
+
+#include "basicTypes/MEtl/string.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @class PropertiesSymbols
+ * @brief Process wide table of interned strings: the names of registered properties.
+ *
+ * Every distinct string is stored once and identified by a small integer id, so structures holding many copies of the
+ * same key (the index of every Properties object, their snapshots) keep a pointer instead of a string. Symbols are
+ * never removed; the returned strings stay valid and unchanged for the lifetime of the process. Only names known to
+ * the program belong here: keys read from files or the command line would never be released.
+ *
+ * Interning takes a lock, resolving an id (name(), hash()) does not.
+ *
+ * Ids only share key storage; nothing compares them. Lookups by string (PropertiesIndex::find(), the section index,
+ * the enum dictionaries) compare characters after matching the hash, because turning a string into its id would take
+ * the lock on every lookup, and callers do not hold ids to look up with.
+ */
+class PropertiesSymbols {
+public:
+  typedef uint32_t Id;
+  static const Id NONE = 0; /** < Never returned by intern().*/
+
+  /**
+   * @brief Get the id of a string, adding the string to the table if needed.
+   *
+   * @param[in] str The string characters.
+   * @param[in] len The number of characters.
+   * @param[in] strHash The PropertiesIndex::hash() of the string.
+   * @return The id of the string.
+   */
+  static Id intern(const char* str, size_t len, uint64_t strHash);
+  static Id intern(const MEtl::string& str);
+
+  /// @brief Get the interned string of an id returned by intern().
+  static const MEtl::string& name(Id id);
+
+  /// @brief Get the PropertiesIndex::hash() of the interned string of an id returned by intern().
+  static uint64_t hash(Id id);
+
+  /// @brief The number of interned strings.
+  static size_t size();
+};
+
+#endif//__PROPERTIES_SYMBOLS__H__
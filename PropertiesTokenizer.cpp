@@ -0,0 +1,116 @@
+/**
+ * @file PropertiesTokenizer.cpp
+ */
+
+#include "PropertiesTokenizer.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile()
+    : _data(nullptr)
+    , _size(0) {}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+bool MappedFile::open(const char* fileName) {
+  close();
+  int fd = ::open(fileName, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+  if (st.st_size == 0) {
+    ::close(fd);
+    return true;
+  }
+  void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  madvise(addr, st.st_size, MADV_SEQUENTIAL);
+  _data = static_cast<const char*>(addr);
+  _size = st.st_size;
+  return true;
+}
+
+void MappedFile::close() {
+  if (_data) {
+    munmap(const_cast<char*>(_data), _size);
+  }
+  _data = nullptr;
+  _size = 0;
+}
+
+IniTokenizer::IniTokenizer(std::string_view buffer, char sep, bool headers)
+    : _buffer(buffer)
+    , _pos(0)
+    , _line(0)
+    , _badLines(0)
+    , _sep(sep)
+    , _headers(headers) {}
+
+std::string_view IniTokenizer::trim(std::string_view str) {
+  size_t begin = 0;
+  size_t end = str.size();
+  while (begin < end && (str[begin] == ' ' || str[begin] == '\t' || str[begin] == '\r')) {
+    ++begin;
+  }
+  while (end > begin && (str[end - 1] == ' ' || str[end - 1] == '\t' || str[end - 1] == '\r')) {
+    --end;
+  }
+  return str.substr(begin, end - begin);
+}
+
+bool IniTokenizer::next(IniRecord& record) {
+  while (_pos < _buffer.size()) {
+    const char* line = _buffer.data() + _pos;
+    size_t remaining = _buffer.size() - _pos;
+    const char* eol = static_cast<const char*>(memchr(line, '\n', remaining));
+    size_t len = eol ? static_cast<size_t>(eol - line) : remaining;
+    _pos += eol ? len + 1 : len;
+    ++_line;
+
+    std::string_view text = trim(std::string_view(line, len));
+    if (text.empty() || text[0] == '#' || text[0] == ';') {
+      continue;
+    }
+    if (text[0] == '[') {
+      size_t close = text.find(']');
+      if (close != std::string_view::npos) {
+        _section = text.substr(0, close + 1);
+        if (!_headers) {
+          continue;
+        }
+        record.section = _section;
+        record.key = std::string_view();
+        record.value = std::string_view();
+        record.line = _line;
+        record.header = true;
+        return true;
+      }
+    }
+    size_t sepPos = text.find(_sep);
+    if (sepPos == std::string_view::npos) {
+      ++_badLines;
+      continue;
+    }
+    record.section = _section;
+    record.key = trim(text.substr(0, sepPos));
+    record.value = trim(text.substr(sepPos + 1));
+    record.line = _line;
+    record.header = false;
+    return true;
+  }
+  return false;
+}
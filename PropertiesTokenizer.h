@@ -0,0 +1,99 @@
+/**
+ * @file PropertiesTokenizer.h
+ */
+
+#ifndef __PROPERTIES_TOKENIZER__H__
+#define __PROPERTIES_TOKENIZER__H__
+
+#include <stddef.h>
+
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * The mapping is released when the object is destroyed or close() is called.
+ */
+class MappedFile {
+public:
+  MappedFile();
+  ~MappedFile();
+
+  /**
+   * @brief Map the given file into memory.
+   *
+   * @param[in] fileName The path of the file to map.
+   * @return true if the file was mapped (an empty file maps to size() == 0), false if it could not be opened or mapped.
+   */
+  bool open(const char* fileName);
+  void close();
+
+  const char* data() const { return _data; }
+  size_t size() const { return _size; }
+  std::string_view view() const { return std::string_view(_data, _size); }
+
+private:
+  MappedFile(const MappedFile& other);
+  MappedFile& operator=(const MappedFile& other);
+
+  const char* _data;
+  size_t _size;
+};
+
+/**
+ * @brief A single "key<sep>value" line of an INI buffer, with the section it belongs to.
+ *
+ * All members point into the tokenized buffer, which must outlive the record.
+ */
+struct IniRecord {
+  std::string_view section; /** < The enclosing section including its brackets ("[name]"), empty if sectionless.*/
+  std::string_view key;     /** < The key, with surrounding white spaces removed.*/
+  std::string_view value;   /** < The value, with surrounding white spaces removed.*/
+  size_t line;              /** < The 1-based line number of the record.*/
+  bool header;              /** < true for a "[<section name>]" line, key and value are then empty.*/
+};
+
+/**
+ * @class IniTokenizer
+ * @brief Single-pass, zero-copy tokenizer of INI formatted buffers.
+ *
+ * Sections are demarcated by lines in the format "[<section name>]". Each property is on its own line in the
+ * "key<sep>value" format. Empty lines and lines starting with '#' or ';' are skipped, as are lines without a separator
+ * (they are counted, see badLines()). Section lines are reported as header records only if requested.
+ */
+class IniTokenizer {
+public:
+  IniTokenizer(std::string_view buffer, char sep, bool headers = false);
+
+  /**
+   * @brief Get the next record of the buffer.
+   *
+   * @param[out] record The next record.
+   * @return true if a record was found, false at the end of the buffer.
+   */
+  bool next(IniRecord& record);
+
+  /**
+   * @brief Get the section the tokenizer is currently in, as seen by the last call to next().
+   *
+   * @return The current section including its brackets, empty if no section header was found yet.
+   */
+  std::string_view section() const { return _section; }
+
+  /// @brief Get the number of non-empty, non-comment lines that had no separator.
+  size_t badLines() const { return _badLines; }
+
+  static std::string_view trim(std::string_view str);
+
+private:
+  std::string_view _buffer;
+  std::string_view _section;
+  size_t _pos;
+  size_t _line;
+  size_t _badLines;
+  char _sep;
+  bool _headers;
+};
+
+#endif//__PROPERTIES_TOKENIZER__H__
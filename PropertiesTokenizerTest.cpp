@@ -0,0 +1,144 @@
+/**
+ * @file PropertiesTokenizerTest.cpp
+ * @brief Behavior tests of IniTokenizer and MappedFile: records, sections, headers, comments and bad lines.
+ */
+
+#include "PropertiesTokenizer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+const char* const INI = "top = 1\n"
+                        "# a comment\n"
+                        "; another comment\n"
+                        "\n"
+                        "[first]\r\n"
+                        "  a =  x y \r\n"
+                        "no separator here\n"
+                        "b=\n"
+                        "[ second ]\n"
+                        "c=1=2\n"
+                        "d=last";
+
+void testRecords() {
+  IniTokenizer tokenizer(INI, '=');
+  IniRecord record;
+  CHECK(tokenizer.next(record));
+  CHECK(record.section.empty());
+  CHECK(record.key == "top");
+  CHECK(record.value == "1");
+  CHECK(record.line == 1);
+  CHECK(!record.header);
+
+  CHECK(tokenizer.next(record));
+  CHECK(record.section == "[first]");
+  CHECK(record.key == "a");
+  CHECK(record.value == "x y");
+  CHECK(record.line == 6);
+
+  CHECK(tokenizer.next(record));
+  CHECK(record.key == "b");
+  CHECK(record.value.empty());
+  CHECK(record.line == 8);
+
+  // only the first separator splits, the rest belongs to the value
+  CHECK(tokenizer.next(record));
+  CHECK(record.section == "[ second ]");
+  CHECK(record.key == "c");
+  CHECK(record.value == "1=2");
+
+  // the last line has no line feed
+  CHECK(tokenizer.next(record));
+  CHECK(record.key == "d");
+  CHECK(record.value == "last");
+  CHECK(record.line == 11);
+
+  CHECK(!tokenizer.next(record));
+  CHECK(tokenizer.badLines() == 1);
+  CHECK(tokenizer.section() == "[ second ]");
+}
+
+void testHeaders() {
+  IniTokenizer tokenizer(INI, '=', true);
+  IniRecord record;
+  size_t records = 0;
+  size_t headers = 0;
+  while (tokenizer.next(record)) {
+    ++records;
+    if (record.header) {
+      ++headers;
+      CHECK(record.key.empty());
+      CHECK(record.value.empty());
+      CHECK(record.line == (headers == 1 ? 5u : 9u));
+    }
+  }
+  CHECK(headers == 2);
+  CHECK(records == 7);
+}
+
+void testSeparator() {
+  IniTokenizer tokenizer("a:1\nb=2\n", ':');
+  IniRecord record;
+  CHECK(tokenizer.next(record));
+  CHECK(record.key == "a");
+  CHECK(record.value == "1");
+  CHECK(!tokenizer.next(record));
+  CHECK(tokenizer.badLines() == 1);
+}
+
+void testEmpty() {
+  IniTokenizer tokenizer(std::string_view(), '=');
+  IniRecord record;
+  CHECK(!tokenizer.next(record));
+  CHECK(tokenizer.badLines() == 0);
+}
+
+void testMappedFile() {
+  char name[] = "/tmp/PropertiesTokenizerTestXXXXXX";
+  int fd = mkstemp(name);
+  CHECK(fd >= 0);
+  if (fd < 0) {
+    return;
+  }
+  std::string text(INI);
+  CHECK(write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+  close(fd);
+
+  MappedFile mapped;
+  CHECK(mapped.open(name));
+  CHECK(mapped.view() == text);
+  mapped.close();
+  CHECK(mapped.data() == nullptr);
+  CHECK(mapped.size() == 0);
+  unlink(name);
+  CHECK(!mapped.open(name));
+}
+}// namespace
+
+int main() {
+  testRecords();
+  testHeaders();
+  testSeparator();
+  testEmpty();
+  testMappedFile();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
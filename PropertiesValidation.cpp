@@ -0,0 +1,128 @@
+/**
+ * @file PropertiesValidation.cpp
+ * @brief Validation of all values of a Properties object in one pass, and of their incremental checksum.
+ */
+
+#include "Properties.h"
+
+#include <stdio.h>
+
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+/**
+ * @brief Accept the canonical dotted-quad IPv4 form: four decimal octets 0-255 without leading zeros.
+ *        The stock IP address validator accepts these; anything else is left to the validator itself.
+ */
+bool isCanonicalIPv4(const char* str, size_t len) {
+  if (len < 7 || len > 15) {
+    return false;
+  }
+  const char* end = str + len;
+  for (int octet = 0; octet < 4; ++octet) {
+    unsigned int val = 0;
+    int digits = 0;
+    while (str != end && static_cast<unsigned int>(*str - '0') <= 9 && digits < 4) {
+      val = val * 10 + static_cast<unsigned int>(*str - '0');
+      ++str;
+      ++digits;
+    }
+    if (digits == 0 || digits > 3 || val > 255 || (digits > 1 && str[-digits] == '0')) {
+      return false;
+    }
+    if (octet < 3) {
+      if (str == end || *str != '.') {
+        return false;
+      }
+      ++str;
+    }
+  }
+  return str == end;
+}
+
+typedef std::unordered_set<std::string_view> ItemSet;
+
+std::atomic<const std::type_info*> g_stockIPAddressValidator(nullptr);
+std::atomic<const std::type_info*> g_stockDiscreteItemsValidator(nullptr);
+
+// a derived or custom validator may reject values the stock one accepts, so only the stock class is bypassed
+bool isStock(const Property::Validator* validator, const std::atomic<const std::type_info*>& stock) {
+  const std::type_info* type = stock.load(std::memory_order_acquire);
+  return type && typeid(*validator) == *type;
+}
+}// namespace
+
+void Properties_SetStockIPAddressValidator(const std::type_info& type) {
+  g_stockIPAddressValidator.store(&type, std::memory_order_release);
+}
+
+void Properties_SetStockDiscreteItemsValidator(const std::type_info& type) {
+  g_stockDiscreteItemsValidator.store(&type, std::memory_order_release);
+}
+
+size_t Properties::validateAll(std::vector<ValidationFailure>& failures, bool stopOnFirstError) const {
+  failures.clear();
+  // the possible values of each discrete items validator, gathered once per call
+  std::unordered_map<const Property::Validator*, std::pair<std::vector<MEtl::string>, ItemSet>> discreteItems;
+  MEtl::string why;// reused: only failures produce text
+  for (PropertiesIndex::Slot slot = 0; slot < _index.slots(); ++slot) {
+    const PropertiesIndex::Entry& entry = _index.at(slot);
+    const Property* property = _index.property(slot);
+    if (!property || !(entry.flags & PropertiesIndex::HAS_VALUE)) {
+      continue;
+    }
+    const MEtl::string& key = *entry.key;
+    const Property::Validator* validator = property->_validator;
+    int type = validator ? validator->validatorType() : DEFAULT_VALIDATOR;
+    bool accepted = false;// by a batch kernel, in place of the stock validator
+    if (type == IP_ADDRESS_VALIDATOR && isStock(validator, g_stockIPAddressValidator)) {
+      accepted = isCanonicalIPv4(entry.value.data(), entry.value.size());
+    } else if (type == DISCRETE_ITEMS_VALIDATOR && isStock(validator, g_stockDiscreteItemsValidator)) {
+      auto found = discreteItems.find(validator);
+      if (found == discreteItems.end()) {
+        found = discreteItems.insert(std::make_pair(validator, std::make_pair(std::vector<MEtl::string>(), ItemSet())))
+                    .first;
+        int numOfPossibleVals = 0;
+        std::vector<MEtl::string>& items = found->second.first;
+        if (getValues(key, items, numOfPossibleVals)) {
+          for (size_t i = 0; i < items.size(); ++i) {
+            found->second.second.insert(std::string_view(items[i].data(), items[i].size()));
+          }
+        }
+      }
+      accepted = found->second.second.count(std::string_view(entry.value.data(), entry.value.size())) != 0;
+    }
+    // the same checks as _acceptValue(): the validator where no kernel accepted the value (so it has the final word on
+    // everything else), then the container's own validate() hook for every value
+    why.clear();
+    if (!(accepted || property->validate(key, entry.value, *this, why)) || !validate(property, key, entry.value, why)) {
+      ValidationFailure failure;
+      failure.key = key;
+      failure.value = entry.value;
+      failure.why = why;
+      failures.push_back(failure);
+      if (stopOnFirstError) {
+        break;
+      }
+    }
+  }
+  return failures.size();
+}
+
+bool Properties::validateIncrementalChecksum(MEtl::string& errMsg, const UInts* checksums) const {
+  if (!checksums || checksums->empty()) {
+    return true;
+  }
+  const uint32_t actual = _index.checksum();
+  for (UInts::const_iterator it = checksums->begin(); it != checksums->end(); ++it) {
+    if (static_cast<uint32_t>(*it) == actual) {
+      return true;
+    }
+  }
+  char buf[16];
+  snprintf(buf, sizeof(buf), "0x%08x", actual);
+  errMsg += "ERROR: incremental checksum " + MEtl::string(buf) + " of " + _name + " is not one of the valid ones\n";
+  return false;
+}
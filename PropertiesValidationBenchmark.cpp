@@ -0,0 +1,77 @@
+/**
+ * @file PropertiesValidationBenchmark.cpp
+ * @brief Micro-benchmark of validateAll() against validate() called per key, over a section of IP addresses.
+ *
+ * Usage: PropertiesValidationBenchmark [iterations] (default: 1000000)
+ */
+
+#include "Properties.h"
+#include "PropertiesBenchmark.h"
+
+#include <stdio.h>
+
+#include <deque>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+using namespace PropertiesBenchmark;
+
+namespace {
+/// @brief An IP address validator registered as the stock one, so validateAll() may bypass it.
+class BenchIPAddressValidator : public Property::Validator {
+public:
+  BenchIPAddressValidator()
+      : Property::Validator(nullptr) {}
+  virtual bool validate(const MEtl::string& key, const MEtl::string& val, const Properties& container,
+                        MEtl::string& why) const {
+    unsigned int a, b, c, d;
+    char tail;
+    if (sscanf(val.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 || a > 255 || b > 255 || c > 255 ||
+        d > 255) {
+      why = "not an IPv4 address: " + val;
+      return false;
+    }
+    return true;
+  }
+  virtual int validatorType() const { return IP_ADDRESS_VALIDATOR; }
+};
+
+struct AddressProperties : public Properties {
+  explicit AddressProperties(size_t count)
+      : Properties("addresses") {
+    for (size_t i = 0; i < count; ++i) {
+      char name[32];
+      snprintf(name, sizeof(name), "address%zu", i);
+      names.push_back(name);
+      addresses.push_back(std::unique_ptr<ProperT<MEtl::string>>(new ProperT<MEtl::string>(
+          this, "10.0.0.1", names.back().c_str(), "an address", Property::DEFAULT_FLAGS, nullptr,
+          BenchIPAddressValidator())));
+    }
+  }
+  std::deque<MEtl::string> names;// property names must outlive the properties
+  std::vector<std::unique_ptr<ProperT<MEtl::string>>> addresses;
+};
+
+void benchmarkValidation(size_t iterations) {
+  const size_t COUNT = 256;
+  Properties_SetStockIPAddressValidator(typeid(BenchIPAddressValidator));
+  AddressProperties properties(COUNT);
+  size_t rounds = iterations / COUNT ? iterations / COUNT : 1;
+  MEtl::string why;
+  double perKey = opsPerSecond(rounds, [&](size_t) {
+    for (size_t i = 0; i < COUNT; ++i) {
+      g_sink += properties.validate(properties.names[i], MEtl::string("10.0.0.1"), why);
+    }
+  });
+  std::vector<Properties::ValidationFailure> failures;
+  double bulk = opsPerSecond(rounds, [&](size_t) { g_sink += properties.validateAll(failures); });
+  report("validation", "validate() per key", perKey * COUNT);
+  report("", "validateAll()", bulk * COUNT, perKey * COUNT);
+}
+}// namespace
+
+int main(int argc, char* argv[]) {
+  benchmarkValidation(iterations(argc, argv));
+  return 0;
+}
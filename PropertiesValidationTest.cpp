@@ -0,0 +1,158 @@
+/**
+ * @file PropertiesValidationTest.cpp
+ * @brief Tests of Properties::validateAll(): the batch kernels bypass only the stock validators, and every value goes
+ *        through the container's validate() hook, as a set does.
+ */
+
+#include "Properties.h"
+
+#include <stdio.h>
+
+#include <typeinfo>
+#include <vector>
+
+namespace {
+int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ++g_failures;                                                            \
+    }                                                                          \
+  } while (0)
+
+// values are set while everything is accepted, then the validators start rejecting
+bool g_reject = false;
+int g_stockCalls = 0;
+
+class StockIPAddressValidator : public Property::Validator {
+public:
+  StockIPAddressValidator()
+      : Property::Validator(nullptr) {}
+  virtual bool validate(const MEtl::string& key, const MEtl::string& val, const Properties& container,
+                        MEtl::string& why) const {
+    ++g_stockCalls;
+    if (g_reject) {
+      why = "rejected by the stock validator";
+      return false;
+    }
+    return true;
+  }
+  virtual int validatorType() const { return IP_ADDRESS_VALIDATOR; }
+};
+
+/// @brief Reports IP_ADDRESS_VALIDATOR but restricts the addresses further, so it must never be bypassed.
+class RestrictedIPAddressValidator : public StockIPAddressValidator {
+public:
+  virtual bool validate(const MEtl::string& key, const MEtl::string& val, const Properties& container,
+                        MEtl::string& why) const {
+    if (g_reject && val == "10.0.0.1") {
+      why = "10.0.0.1 is reserved";
+      return false;
+    }
+    return true;
+  }
+};
+
+/// @brief Reports DISCRETE_ITEMS_VALIDATOR without being registered as the stock one, so it must always be called.
+class CustomItemsValidator : public Property::Validator {
+public:
+  CustomItemsValidator()
+      : Property::Validator(nullptr) {}
+  virtual bool validate(const MEtl::string& key, const MEtl::string& val, const Properties& container,
+                        MEtl::string& why) const {
+    if (g_reject) {
+      why = "not one of the items";
+      return false;
+    }
+    return true;
+  }
+  virtual int validatorType() const { return DISCRETE_ITEMS_VALIDATOR; }
+};
+
+struct ValidatedProperties : public Properties {
+  ValidatedProperties()
+      : Properties("validated")
+      , stock(this, "10.0.0.1", "stock", "a stock validated address", Property::DEFAULT_FLAGS, nullptr,
+              StockIPAddressValidator())
+      , restricted(this, "10.0.0.1", "restricted", "a restricted address", Property::DEFAULT_FLAGS, nullptr,
+                   RestrictedIPAddressValidator())
+      , items(this, "first", "items", "a custom item", Property::DEFAULT_FLAGS, nullptr, CustomItemsValidator())
+      , hooked(this, "10.0.0.2", "hooked", "an address the container rejects", Property::DEFAULT_FLAGS, nullptr,
+               StockIPAddressValidator()) {}
+  ProperT<MEtl::string> stock;
+  ProperT<MEtl::string> restricted;
+  ProperT<MEtl::string> items;
+  ProperT<MEtl::string> hooked;
+
+private:
+  virtual bool validate(const Property* property, const MEtl::string& key, const MEtl::string& val,
+                        MEtl::string& whyNot) const {
+    if (g_reject && key == "hooked") {
+      whyNot = "rejected by the container";
+      return false;
+    }
+    return true;
+  }
+};
+
+bool hasFailure(const std::vector<Properties::ValidationFailure>& failures, const char* key) {
+  for (size_t i = 0; i < failures.size(); ++i) {
+    if (failures[i].key == key) {
+      return !failures[i].why.empty();
+    }
+  }
+  return false;
+}
+
+void testAllAccepted() {
+  g_reject = false;
+  Properties_SetStockIPAddressValidator(typeid(StockIPAddressValidator));
+  ValidatedProperties properties;
+  std::vector<Properties::ValidationFailure> failures;
+  CHECK(properties.validateAll(failures) == 0);
+  CHECK(failures.empty());
+}
+
+void testOnlyStockBypassed() {
+  g_reject = false;
+  Properties_SetStockIPAddressValidator(typeid(StockIPAddressValidator));
+  ValidatedProperties properties;
+  g_reject = true;
+  g_stockCalls = 0;
+  std::vector<Properties::ValidationFailure> failures;
+  properties.validateAll(failures);
+  // the canonical address of the stock validator is accepted by the kernel, without calling it
+  CHECK(!hasFailure(failures, "stock"));
+  CHECK(g_stockCalls == 0);
+  // the subclass, the unregistered discrete items validator and the container hook all have their say
+  CHECK(hasFailure(failures, "restricted"));
+  CHECK(hasFailure(failures, "items"));
+  CHECK(hasFailure(failures, "hooked"));
+  CHECK(failures.size() == 3);
+  g_reject = false;
+}
+
+void testStopOnFirstError() {
+  g_reject = false;
+  ValidatedProperties properties;
+  g_reject = true;
+  std::vector<Properties::ValidationFailure> failures;
+  CHECK(properties.validateAll(failures, true) == 1);
+  CHECK(failures.size() == 1);
+  g_reject = false;
+}
+}// namespace
+
+int main() {
+  testAllAccepted();
+  testOnlyStockBypassed();
+  testStopOnFirstError();
+  if (g_failures) {
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
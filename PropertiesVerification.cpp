@@ -0,0 +1,78 @@
+/**
+ * @file PropertiesVerification.cpp
+ * @brief Parallel verification of the safety related properties of several Properties objects.
+ */
+
+#include "Properties.h"
+#include "PropertiesParallel.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+/// @brief Lower `first` to `container` unless it is lower already.
+void lowerFirstFailure(std::atomic<size_t>& first, size_t container) {
+  size_t current = first.load(std::memory_order_relaxed);
+  while (container < current && !first.compare_exchange_weak(current, container, std::memory_order_relaxed)) {
+  }
+}
+}// namespace
+
+bool Properties::verifyAllPropsParallel(const std::vector<Properties*>& containers,
+                                        std::vector<VerificationFailure>& failures, bool stopOnFirstError,
+                                        unsigned int threads) {
+  failures.clear();
+  // one result per container, written only by the thread verifying the container
+  std::vector<uint8_t> verified(containers.size(), 1);
+  std::atomic<size_t> firstFailure(containers.size());
+  Properties_ParallelFor(containers.size(), threads, [&](size_t i) {
+    // a failure in a container ordered before this one decides the result already
+    if (stopOnFirstError && i > firstFailure.load(std::memory_order_relaxed)) {
+      return;
+    }
+    // through the virtual, so containers overriding the verification keep their behavior
+    if (!containers[i]->verifyAllProps(stopOnFirstError)) {
+      verified[i] = 0;
+      lowerFirstFailure(firstFailure, i);
+    }
+  });
+
+  // the containers before the first failure all ran, so the report does not depend on scheduling
+  size_t last = stopOnFirstError ? std::min(containers.size(), firstFailure.load() + 1) : containers.size();
+  for (size_t i = 0; i < last; ++i) {
+    if (verified[i]) {
+      continue;
+    }
+    size_t reported = failures.size();
+    const std::list<const Property*>& properties = containers[i]->properTies();
+    for (std::list<const Property*>::const_iterator it = properties.begin(); it != properties.end(); ++it) {
+      const Property* property = *it;
+      if (!property->requiresVerification()) {
+        continue;
+      }
+      VerificationStatus_e status = property->getLastVerificationStatus();
+      if (status == E_VERIFICATION_SUCCEEDED) {
+        continue;
+      }
+      VerificationFailure failure;
+      failure.container = containers[i];
+      failure.key = property->name;
+      failure.status = status;
+      failures.push_back(failure);
+      if (stopOnFirstError) {
+        // the serial verification stopped here; the properties after it were not verified by this call
+        break;
+      }
+    }
+    if (failures.size() == reported) {
+      // rejected by the container itself rather than by one of its properties
+      VerificationFailure failure;
+      failure.container = containers[i];
+      failure.status = E_VERIFICATION_FAILED;
+      failures.push_back(failure);
+    }
+  }
+  return failures.empty();
+}